@@ -1,13 +1,40 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BlueprintPropertyComment.h"
+#include "PropertyCommentAssetTags.h"
+#include "PropertyCommentExtensionRegistry.h"
+#include "PropertyCommentSidecar.h"
+#include "PropertyCommentStats.h"
+
+DEFINE_LOG_CATEGORY(LogBlueprintPropertyComment);
+
+DEFINE_STAT(STAT_PropertyComment_ResolveBlueprint);
+DEFINE_STAT(STAT_PropertyComment_BuildPath);
+DEFINE_STAT(STAT_PropertyComment_FindExtension);
+DEFINE_STAT(STAT_PropertyComment_FetchComment);
+DEFINE_STAT(STAT_PropertyComment_UpdateRowDisplay);
+DEFINE_STAT(STAT_PropertyComment_PathLookups);
+DEFINE_STAT(STAT_PropertyComment_ResolveCacheHits);
+DEFINE_STAT(STAT_PropertyComment_ResolveCacheMisses);
+DEFINE_STAT(STAT_PropertyComment_DisplayCacheHits);
+DEFINE_STAT(STAT_PropertyComment_DisplayCacheMisses);
+DEFINE_STAT(STAT_PropertyComment_PreviewLayouts);
+DEFINE_STAT(STAT_PropertyComment_NamesCreated);
 
 void FBlueprintPropertyCommentModule::StartupModule()
 {
+#if WITH_EDITORONLY_DATA
+	PropertyCommentAssetTags::Register();
+#endif
 }
 
 void FBlueprintPropertyCommentModule::ShutdownModule()
 {
+#if WITH_EDITORONLY_DATA
+	PropertyCommentAssetTags::Unregister();
+	FPropertyCommentExtensionRegistry::Reset();
+	FPropertyCommentSidecar::Shutdown();
+#endif
 }
 
 IMPLEMENT_MODULE(FBlueprintPropertyCommentModule, BlueprintPropertyComment)
\ No newline at end of file
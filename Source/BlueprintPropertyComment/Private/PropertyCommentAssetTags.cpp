@@ -0,0 +1,114 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentAssetTags.h"
+#include "PropertyCommentExtension.h"
+#include "AssetRegistry/AssetData.h"
+#include "Engine/Blueprint.h"
+
+namespace PropertyCommentAssetTags
+{
+	const FName CommentCountTag{"PropertyCommentCount"};
+	const FName CommentDigestTag{"PropertyCommentDigest"};
+
+	static constexpr int32 HashDigits = 8;
+
+	int32 GetCommentCount(const FAssetData& AssetData)
+	{
+		int32 Count = 0;
+		AssetData.GetTagValue(CommentCountTag, Count);
+		return Count;
+	}
+
+	bool HasCommentCount(const FAssetData& AssetData)
+	{
+		return AssetData.TagsAndValues.Contains(CommentCountTag);
+	}
+
+	bool HasCommentOnPath(const FAssetData& AssetData, const FPropertyCommentPath& PropertyPath)
+	{
+		FString Digest;
+		if (!AssetData.GetTagValue(CommentDigestTag, Digest))
+		{
+			return false;
+		}
+
+		// Hashes are sorted, so a binary search over the fixed-width entries finds the key
+		const uint32 Hash = GetStablePathHash(PropertyPath);
+		int32 Low = 0;
+		int32 High = Digest.Len() / HashDigits - 1;
+		while (Low <= High)
+		{
+			const int32 Middle = (Low + High) / 2;
+			const uint32 Entry = FParse::HexNumber(*Digest.Mid(Middle * HashDigits, HashDigits));
+			if (Entry == Hash)
+			{
+				return true;
+			}
+
+			if (Entry < Hash)
+			{
+				Low = Middle + 1;
+			}
+			else
+			{
+				High = Middle - 1;
+			}
+		}
+		return false;
+	}
+
+	uint32 GetStablePathHash(const FPropertyCommentPath& PropertyPath)
+	{
+		return FCrc::StrCrc32(*PropertyPath.ToString().ToLower());
+	}
+
+#if WITH_EDITORONLY_DATA
+	static FDelegateHandle ExtraObjectTagsHandle;
+
+	static void HandleGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags)
+	{
+		const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+		if (!Blueprint || Blueprint->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			return;
+		}
+
+		// Written as 0 too, so that blueprints without comments can be told apart from ones saved before the tags existed
+		const UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
+		const int32 NumComments = IsValid(Extension) ? Extension->GetNumComments() : 0;
+		OutTags.Emplace(CommentCountTag, LexToString(NumComments), UObject::FAssetRegistryTag::TT_Numerical);
+		if (NumComments == 0)
+		{
+			return;
+		}
+
+		TArray<uint32> Hashes;
+		Hashes.Reserve(Extension->GetNumComments());
+		Extension->ForEachCommentedPath([&Hashes](const FPropertyCommentPath& PropertyPath)
+		{
+			Hashes.Add(GetStablePathHash(PropertyPath));
+		});
+		Hashes.Sort();
+
+		FString Digest;
+		Digest.Reserve(Hashes.Num() * HashDigits);
+		for (const uint32 Hash : Hashes)
+		{
+			Digest.Appendf(TEXT("%08x"), Hash);
+		}
+
+		OutTags.Emplace(CommentDigestTag, MoveTemp(Digest), UObject::FAssetRegistryTag::TT_Hidden);
+	}
+
+	void Register()
+	{
+		ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&HandleGetExtraObjectTags);
+	}
+
+	void Unregister()
+	{
+		UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(ExtraObjectTagsHandle);
+		ExtraObjectTagsHandle.Reset();
+	}
+#endif
+}
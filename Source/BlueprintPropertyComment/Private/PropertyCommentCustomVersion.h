@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+/** Versions of the serialized UPropertyCommentExtension data. */
+struct FPropertyCommentCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+
+		// Comment texts moved out of the tagged properties into a lazily loaded payload
+		LazyCommentPayload,
+
+		// The comment payload starts with its format, which may be a deduplicated string table
+		CommentPayloadFormat,
+
+		// -----<new versions can be added above this line>-------------------------------------------------
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
@@ -2,24 +2,71 @@
 
 
 #include "PropertyCommentExtension.h"
+#include "PropertyCommentCustomVersion.h"
+#include "PropertyCommentExtensionRegistry.h"
+#include "PropertyCommentSettings.h"
+#include "PropertyCommentSidecar.h"
+#include "PropertyCommentStats.h"
+#include "PropertyCommentTokenizer.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+#include "Engine/Blueprint.h"
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectSaveContext.h"
+
+const FGuid FPropertyCommentCustomVersion::GUID{0x6C1F3A52, 0x8E7B4D09, 0xA41C2F6D, 0x93B05E18};
+static FCustomVersionRegistration GRegisterPropertyCommentCustomVersion{FPropertyCommentCustomVersion::GUID, FPropertyCommentCustomVersion::LatestVersion, TEXT("PropertyCommentVer")};
 
 #if WITH_EDITORONLY_DATA
 
+namespace
+{
+	enum class ECommentPayloadFormat : uint8
+	{
+		Texts,
+		StringTable,
+	};
+
+	/** Payloads larger than this are compressed on disk. Small ones would not gain enough to pay for the decompression. */
+	constexpr int32 CompressedPayloadThreshold = 4 * 1024;
+
+	struct FCaseSensitiveStringKeyFuncs : TDefaultMapHashableKeyFuncs<FString, int32, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	bool UseCompactCommentTexts()
+	{
+		return GetDefault<UPropertyCommentSettings>()->bCompactCommentTexts;
+	}
+}
+
+uint32 UPropertyCommentExtension::GlobalRevision = 0;
+
 UPropertyCommentExtension* UPropertyCommentExtension::GetPropertyCommentExtension(const UBlueprint* Blueprint)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::FindExtension);
+	SCOPE_CYCLE_COUNTER(STAT_PropertyComment_FindExtension);
+
 	check(IsValid(Blueprint));
-	const TObjectPtr<UBlueprintExtension>* FindResult = Blueprint->Extensions.FindByPredicate(
-	[](const TObjectPtr<UBlueprintExtension> Ext)
+	UPropertyCommentExtension* Extension = FPropertyCommentExtensionRegistry::Find(Blueprint);
+	if (!Extension && FPropertyCommentSidecar::IsEnabled())
 	{
-		return IsValid(Ext) && Ext->IsA<UPropertyCommentExtension>();
-	});
+		// Sidecar files are only read the first time their blueprint is asked for
+		Extension = FPropertyCommentSidecar::Load(Blueprint);
+	}
+	return Extension;
+}
 
-	if (FindResult)
+void UPropertyCommentExtension::GetSidecarBlueprints(TArray<FSoftObjectPath>& OutBlueprints)
+{
+	if (FPropertyCommentSidecar::IsEnabled())
 	{
-		return CastChecked<UPropertyCommentExtension>(*FindResult);
+		FPropertyCommentSidecar::GetBlueprints(OutBlueprints);
 	}
-
-	return nullptr;
 }
 
 UPropertyCommentExtension* UPropertyCommentExtension::GetOrCreatePropertyCommentExtension(UBlueprint* Blueprint)
@@ -29,15 +76,35 @@ UPropertyCommentExtension* UPropertyCommentExtension::GetOrCreatePropertyComment
 	UPropertyCommentExtension* Extension = GetPropertyCommentExtension(Blueprint);
 	if (!IsValid(Extension))
 	{
-		Extension = NewObject<UPropertyCommentExtension>(Blueprint);
+		// Creation is rare, so fall back to a scan in case an existing extension was never registered
+		const TObjectPtr<UBlueprintExtension>* FindResult = Blueprint->Extensions.FindByPredicate(
+		[](const TObjectPtr<UBlueprintExtension> Ext)
+		{
+			return IsValid(Ext) && Ext->IsA<UPropertyCommentExtension>();
+		});
+
+		if (FindResult)
+		{
+			Extension = CastChecked<UPropertyCommentExtension>(*FindResult);
+			FPropertyCommentExtensionRegistry::Register(Extension);
+			return Extension;
+		}
+
+		if (FPropertyCommentSidecar::IsEnabled() && Blueprint->BlueprintGuid.IsValid())
+		{
+			return FPropertyCommentSidecar::Create(Blueprint);
+		}
+
+		Extension = NewObject<UPropertyCommentExtension>(Blueprint, NAME_None, RF_Transactional);
 		Blueprint->Extensions.Add(Extension);
 		Blueprint->MarkPackageDirty();
+		FPropertyCommentExtensionRegistry::Register(Extension);
 	}
 
 	return Extension;
 }
 
-void UPropertyCommentExtension::TryAddPropertyComment(UBlueprint* Blueprint, const FName& PropertyKey, FText Comment)
+void UPropertyCommentExtension::TryAddPropertyComment(UBlueprint* Blueprint, const FPropertyCommentPath& PropertyPath, FText Comment)
 {
 	// Check if it's valid low level in case the blueprint had already been deleted
 	if (IsValid(Blueprint) && Blueprint->IsValidLowLevel())
@@ -45,12 +112,12 @@ void UPropertyCommentExtension::TryAddPropertyComment(UBlueprint* Blueprint, con
 		UPropertyCommentExtension* Ext = GetOrCreatePropertyCommentExtension(Blueprint);
 		check(IsValid(Ext));
 
-		Ext->AddComment(PropertyKey, MoveTemp(Comment));
-		Blueprint->MarkPackageDirty();
+		Ext->AddComment(PropertyPath, MoveTemp(Comment));
+		Ext->MarkCommentsDirty();
 	}
 }
 
-void UPropertyCommentExtension::TryRemovePropertyComment(UBlueprint* Blueprint, const FName& PropertyKey)
+void UPropertyCommentExtension::TryRemovePropertyComment(UBlueprint* Blueprint, const FPropertyCommentPath& PropertyPath)
 {
 	// Check if it's valid low level in case the blueprint had already been deleted
 	if (IsValid(Blueprint) && Blueprint->IsValidLowLevel())
@@ -58,19 +125,84 @@ void UPropertyCommentExtension::TryRemovePropertyComment(UBlueprint* Blueprint,
 		UPropertyCommentExtension* Ext = GetOrCreatePropertyCommentExtension(Blueprint);
 		check(IsValid(Ext));
 
-		Ext->RemoveComment(PropertyKey);
-		Blueprint->MarkPackageDirty();
+		Ext->RemoveComment(PropertyPath);
+		Ext->MarkCommentsDirty();
 	}
 }
 
-bool UPropertyCommentExtension::HasComment(const FName& PropertyKey) const
+int32 UPropertyCommentExtension::TryAddPropertyComments(TConstArrayView<FPropertyCommentTarget> Targets, const FText& Comment)
 {
-	return Comments.Contains(PropertyKey);
+	TSet<UPropertyCommentExtension*> Modified;
+	int32 NumAdded = 0;
+	for (const FPropertyCommentTarget& Target : Targets)
+	{
+		if (!IsValid(Target.Blueprint) || !Target.Blueprint->IsValidLowLevel() || Target.PropertyPath.IsEmpty())
+		{
+			continue;
+		}
+
+		UPropertyCommentExtension* Ext = GetOrCreatePropertyCommentExtension(Target.Blueprint);
+		check(IsValid(Ext));
+
+		bool bAlreadyModified = false;
+		Modified.Add(Ext, &bAlreadyModified);
+		if (!bAlreadyModified)
+		{
+			// Dirtying is left to MarkCommentsDirty below, which knows about sidecar files
+			Ext->Modify(false);
+		}
+
+		Ext->AddComment(Target.PropertyPath, Comment);
+		++NumAdded;
+	}
+
+	for (UPropertyCommentExtension* Ext : Modified)
+	{
+		Ext->MarkCommentsDirty();
+	}
+	return NumAdded;
 }
 
-bool UPropertyCommentExtension::GetComment(const FName& PropertyKey, FText& OutComment) const
+int32 UPropertyCommentExtension::TryRemovePropertyComments(TConstArrayView<FPropertyCommentTarget> Targets)
 {
-	const FText* FindResult = Comments.Find(PropertyKey);
+	TSet<UPropertyCommentExtension*> Modified;
+	int32 NumRemoved = 0;
+	for (const FPropertyCommentTarget& Target : Targets)
+	{
+		// Blueprints without comments are left without an extension
+		UPropertyCommentExtension* Ext = IsValid(Target.Blueprint) && Target.Blueprint->IsValidLowLevel() ? GetPropertyCommentExtension(Target.Blueprint) : nullptr;
+		if (!IsValid(Ext) || !Ext->HasComment(Target.PropertyPath))
+		{
+			continue;
+		}
+
+		bool bAlreadyModified = false;
+		Modified.Add(Ext, &bAlreadyModified);
+		if (!bAlreadyModified)
+		{
+			Ext->Modify(false);
+		}
+
+		Ext->RemoveComment(Target.PropertyPath);
+		++NumRemoved;
+	}
+
+	for (UPropertyCommentExtension* Ext : Modified)
+	{
+		Ext->MarkCommentsDirty();
+	}
+	return NumRemoved;
+}
+
+bool UPropertyCommentExtension::HasComment(const FPropertyCommentPath& PropertyPath) const
+{
+	const int32 NodeIndex = FindNode(PropertyPath);
+	return NodeIndex != INDEX_NONE && NodeComments.Contains(NodeIndex);
+}
+
+bool UPropertyCommentExtension::GetComment(const FPropertyCommentPath& PropertyPath, FText& OutComment) const
+{
+	const FText* FindResult = FindComment(PropertyPath);
 	if (FindResult)
 	{
 		OutComment = *FindResult;
@@ -78,21 +210,879 @@ bool UPropertyCommentExtension::GetComment(const FName& PropertyKey, FText& OutC
 	return FindResult != nullptr;
 }
 
-void UPropertyCommentExtension::AddComment(const FName& PropertyKey, FText Comment)
+const FText* UPropertyCommentExtension::FindComment(const FPropertyCommentPath& PropertyPath) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::FetchComment);
+	SCOPE_CYCLE_COUNTER(STAT_PropertyComment_FetchComment);
+
+	const int32 NodeIndex = FindNode(PropertyPath);
+	const FText* FindResult = NodeIndex != INDEX_NONE ? NodeComments.Find(NodeIndex) : nullptr;
+	if (FindResult)
+	{
+		EnsureCommentTextsLoaded();
+	}
+	return FindResult;
+}
+
+void UPropertyCommentExtension::AddComment(const FPropertyCommentPath& PropertyPath, FText Comment)
+{
+	if (AddCommentNoNotify(PropertyPath, MoveTemp(Comment)))
+	{
+		NotifyCommentsChanged(&PropertyPath);
+	}
+}
+
+bool UPropertyCommentExtension::AddCommentNoNotify(const FPropertyCommentPath& PropertyPath, FText Comment)
+{
+	EnsureCommentTextsLoaded();
+
+	const int32 NodeIndex = FindOrAddNode(PropertyPath);
+	if (NodeIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (UseCompactCommentTexts())
+	{
+		Comment = ShareCommentText(Comment);
+	}
+
+	if (FText* Existing = NodeComments.Find(NodeIndex))
+	{
+		RemoveFromTokenIndex(NodeIndex, *Existing);
+		AddToTokenIndex(NodeIndex, Comment);
+		*Existing = MoveTemp(Comment);
+	}
+	else
+	{
+		AddToTokenIndex(NodeIndex, Comment);
+		NodeComments.Emplace(NodeIndex, MoveTemp(Comment));
+		AdjustNumComments(NodeIndex, 1);
+	}
+	return true;
+}
+
+void UPropertyCommentExtension::RemoveComment(const FPropertyCommentPath& PropertyPath)
+{
+	EnsureCommentTextsLoaded();
+
+	// Nodes left without comments are kept until the next save compacts the table
+	const int32 NodeIndex = FindNode(PropertyPath);
+	FText RemovedComment;
+	if (NodeIndex != INDEX_NONE && NodeComments.RemoveAndCopyValue(NodeIndex, RemovedComment))
+	{
+		RemoveFromTokenIndex(NodeIndex, RemovedComment);
+		AdjustNumComments(NodeIndex, -1);
+		NotifyCommentsChanged(&PropertyPath);
+	}
+}
+
+bool UPropertyCommentExtension::MarkCommentsDirty()
+{
+	if (bStoredInSidecar)
+	{
+		return FPropertyCommentSidecar::Save(this);
+	}
+
+	MarkPackageDirty();
+	return true;
+}
+
+bool UPropertyCommentExtension::IsStoredInSidecar() const
+{
+	return bStoredInSidecar;
+}
+
+UBlueprint* UPropertyCommentExtension::GetBlueprint() const
+{
+	return bStoredInSidecar ? SidecarBlueprint.Get() : GetTypedOuter<UBlueprint>();
+}
+
+int32 UPropertyCommentExtension::GetNumCommentsBelow(const FPropertyCommentPath& PropertyPath) const
+{
+	const int32 NodeIndex = FindNode(PropertyPath);
+	if (NodeIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	const int32 NumOwnComments = NodeComments.Contains(NodeIndex) ? 1 : 0;
+	return PathNodes[NodeIndex].NumComments - NumOwnComments;
+}
+
+int32 UPropertyCommentExtension::GetNumComments() const
+{
+	return NodeComments.Num();
+}
+
+FPropertyCommentPath UPropertyCommentExtension::GetPathFromNode(int32 NodeIndex) const
+{
+	FPropertyCommentPath Path;
+	for (; PathNodes.IsValidIndex(NodeIndex); NodeIndex = PathNodes[NodeIndex].Parent)
+	{
+		Path.Segments.Add(PathNodes[NodeIndex].Segment);
+	}
+	Algo::Reverse(Path.Segments);
+	return Path;
+}
+
+void UPropertyCommentExtension::ForEachComment(TFunctionRef<void(const FPropertyCommentPath&, const FText&)> Callback) const
+{
+	EnsureCommentTextsLoaded();
+	for (const TPair<int32, FText>& Pair : NodeComments)
+	{
+		Callback(GetPathFromNode(Pair.Key), Pair.Value);
+	}
+}
+
+void UPropertyCommentExtension::ForEachCommentedPath(TFunctionRef<void(const FPropertyCommentPath&)> Callback) const
+{
+	for (const TPair<int32, FText>& Pair : NodeComments)
+	{
+		Callback(GetPathFromNode(Pair.Key));
+	}
+}
+
+void UPropertyCommentExtension::FindCommentsMatching(FStringView Query, TArray<FPropertyCommentPath>& OutPaths) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::FindCommentsMatching);
+
+	TArray<FString, TInlineAllocator<8>> Tokens;
+	PropertyCommentTokenizer::Tokenize(Query, Tokens);
+	if (Tokens.Num() == 0 || NodeComments.Num() == 0)
+	{
+		return;
+	}
+
+	EnsureTokenIndexBuilt();
+
+	// A trailing space ends the last word, until then it is still being typed and matches as a prefix
+	FString Prefix;
+	if (!FChar::IsWhitespace(Query[Query.Len() - 1]))
+	{
+		Prefix = Tokens.Pop(false);
+	}
+
+	TArray<const TArray<int32>*, TInlineAllocator<8>> Postings;
+	for (const FString& Token : Tokens)
+	{
+		const TArray<int32>* Nodes = TokenIndex.Find(Token);
+		if (!Nodes)
+		{
+			return;
+		}
+		Postings.Add(Nodes);
+	}
+
+	TArray<int32> PrefixNodes;
+	if (!Prefix.IsEmpty())
+	{
+		if (bTokenVocabularyDirty)
+		{
+			TokenIndex.GetKeys(TokenVocabulary);
+			TokenVocabulary.Sort();
+			bTokenVocabularyDirty = false;
+		}
+
+		for (int32 Index = Algo::LowerBound(TokenVocabulary, Prefix); Index < TokenVocabulary.Num(); ++Index)
+		{
+			const FString& Token = TokenVocabulary[Index];
+			if (!Token.StartsWith(Prefix, ESearchCase::CaseSensitive))
+			{
+				break;
+			}
+			PrefixNodes.Append(TokenIndex.FindChecked(Token));
+		}
+
+		if (PrefixNodes.Num() == 0)
+		{
+			return;
+		}
+		PrefixNodes.Sort();
+		PrefixNodes.SetNum(Algo::Unique(PrefixNodes));
+		Postings.Add(&PrefixNodes);
+	}
+
+	// Starting from the rarest word keeps every later intersection as small as possible
+	Postings.Sort([](const TArray<int32>& A, const TArray<int32>& B)
+	{
+		return A.Num() < B.Num();
+	});
+
+	TArray<int32> Matches = *Postings[0];
+	TArray<int32> Intersection;
+	for (int32 PostingIndex = 1; PostingIndex < Postings.Num() && Matches.Num() > 0; ++PostingIndex)
+	{
+		const TArray<int32>& Nodes = *Postings[PostingIndex];
+		Intersection.Reset();
+		int32 A = 0;
+		int32 B = 0;
+		while (A < Matches.Num() && B < Nodes.Num())
+		{
+			if (Matches[A] < Nodes[B])
+			{
+				++A;
+			}
+			else if (Matches[A] > Nodes[B])
+			{
+				++B;
+			}
+			else
+			{
+				Intersection.Add(Matches[A]);
+				++A;
+				++B;
+			}
+		}
+		Swap(Matches, Intersection);
+	}
+
+	OutPaths.Reserve(OutPaths.Num() + Matches.Num());
+	for (const int32 NodeIndex : Matches)
+	{
+		OutPaths.Add(GetPathFromNode(NodeIndex));
+	}
+}
+
+int32 UPropertyCommentExtension::RenameProperty(FName OldName, FName NewName, EPropertyCommentRenameScope Scope)
+{
+	if (OldName == NewName)
+	{
+		return 0;
+	}
+
+	// Merging nodes moves texts around, which must not happen to placeholders
+	EnsureCommentTextsLoaded();
+
+	TArray<int32, TInlineAllocator<8>> NodesToRename;
+	NodesByName.MultiFind(OldName, NodesToRename);
+
+	// Element segments reuse the name of their container, so they follow the container's scope
+	const auto GetContainerNode = [this, OldName](int32 NodeIndex)
+	{
+		const FPropertyCommentPathNode& Node = PathNodes[NodeIndex];
+		const bool bIsElement = Node.Segment.ArrayIndex != INDEX_NONE && Node.Parent != INDEX_NONE && PathNodes[Node.Parent].Segment.Name == OldName;
+		return bIsElement ? Node.Parent : NodeIndex;
+	};
+
+	NodesToRename.RemoveAll([this, Scope, &GetContainerNode](int32 NodeIndex)
+	{
+		const bool bIsTopLevel = PathNodes[GetContainerNode(NodeIndex)].Parent == INDEX_NONE;
+		return PathNodes[NodeIndex].NumComments <= 0 || bIsTopLevel != (Scope == EPropertyCommentRenameScope::TopLevel);
+	});
+
+	int32 NumRenamed = 0;
+	for (const int32 NodeIndex : NodesToRename)
+	{
+		if (GetContainerNode(NodeIndex) == NodeIndex)
+		{
+			NumRenamed += PathNodes[NodeIndex].NumComments;
+		}
+	}
+
+	// Parents precede their children, so containers are renamed before their elements
+	NodesToRename.Sort();
+
+	bool bMerged = false;
+	for (const int32 NodeIndex : NodesToRename)
+	{
+		// Skip nodes that an earlier merge already folded into another one
+		const FPropertyCommentPathNode& Node = PathNodes[NodeIndex];
+		const int32* LookupIndex = NodeLookup.Find({Node.Parent, Node.Segment});
+		if (LookupIndex && *LookupIndex == NodeIndex)
+		{
+			bMerged |= RenameNode(NodeIndex, NewName);
+		}
+	}
+
+	if (NumRenamed > 0)
+	{
+		RebuildNumComments();
+		if (bMerged)
+		{
+			// Drops the nodes left empty by merging
+			CompactPathNodes();
+		}
+		NotifyCommentsChanged();
+	}
+	return NumRenamed;
+}
+
+FPropertyCommentSnapshotRef UPropertyCommentExtension::GetSnapshot() const
+{
+	check(IsInGameThread());
+
+	if (!Snapshot.IsValid() || Snapshot->GetRevision() != Revision)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::BuildSnapshot);
+
+		TMap<FPropertyCommentPath, FString> SnapshotComments;
+		SnapshotComments.Reserve(NodeComments.Num());
+		ForEachComment([&SnapshotComments](const FPropertyCommentPath& PropertyPath, const FText& Comment)
+		{
+			SnapshotComments.Add(PropertyPath, Comment.ToString());
+		});
+
+		// Replaces the pointer only, readers holding the previous snapshot keep it alive
+		Snapshot = MakeShared<FPropertyCommentSnapshot, ESPMode::ThreadSafe>(FSoftObjectPath{GetBlueprint()}, Revision, MoveTemp(SnapshotComments));
+	}
+	return Snapshot.ToSharedRef();
+}
+
+uint32 UPropertyCommentExtension::GetRevision() const
+{
+	return Revision;
+}
+
+uint32 UPropertyCommentExtension::GetGlobalRevision()
+{
+	return GlobalRevision;
+}
+
+FOnPropertyCommentsChanged& UPropertyCommentExtension::OnCommentsChanged()
+{
+	static FOnPropertyCommentsChanged Delegate;
+	return Delegate;
+}
+
+SIZE_T UPropertyCommentExtension::GetAllocatedSize() const
 {
-	if (Comments.Contains(PropertyKey))
+	SIZE_T Size = Comments.GetAllocatedSize() + PathNodes.GetAllocatedSize() + NodeComments.GetAllocatedSize()
+		+ NodeLookup.GetAllocatedSize() + NodesByName.GetAllocatedSize() + PendingTextKeys.GetAllocatedSize() + SharedTexts.GetAllocatedSize();
+
+	Size += TokenIndex.GetAllocatedSize() + TokenVocabulary.GetAllocatedSize();
+	for (const TPair<FString, TArray<int32>>& Pair : TokenIndex)
+	{
+		Size += Pair.Key.GetAllocatedSize() + Pair.Value.GetAllocatedSize();
+	}
+	for (const FString& Token : TokenVocabulary)
+	{
+		Size += Token.GetAllocatedSize();
+	}
+
+	Size += CommentPayload.IsBulkDataLoaded() ? CommentPayload.GetBulkDataSize() : 0;
+
+	// Approximation, localized texts may also share their string with texts outside of the extension
+	TSet<const FString*> CountedStrings;
+	for (const TPair<int32, FText>& Pair : NodeComments)
 	{
-		Comments[PropertyKey] = MoveTemp(Comment);
+		const FString& String = Pair.Value.ToString();
+		bool bAlreadyCounted = false;
+		CountedStrings.Add(&String, &bAlreadyCounted);
+		Size += bAlreadyCounted ? 0 : String.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void UPropertyCommentExtension::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FPropertyCommentCustomVersion::GUID);
+
+	// Whatever gets written has to carry the real texts, not the placeholders
+	if (Ar.IsSaving() && !Ar.IsObjectReferenceCollector())
+	{
+		EnsureCommentTextsLoaded();
+	}
+
+	// Only packages split the texts off, duplication and transactions keep the plain layout
+	const bool bIsPackage = Ar.IsPersistent() && Ar.GetLinker() && !Ar.IsTransacting();
+	if (bIsPackage && Ar.IsSaving())
+	{
+		TMap<int32, FText> Texts = MoveTemp(NodeComments);
+		NodeComments.Reset();
+		Super::Serialize(Ar);
+		NodeComments = MoveTemp(Texts);
+		SerializeCommentPayload(Ar);
 	}
 	else
 	{
-		Comments.Emplace(PropertyKey, MoveTemp(Comment));
+		Super::Serialize(Ar);
+		if (bIsPackage && Ar.IsLoading() && Ar.CustomVer(FPropertyCommentCustomVersion::GUID) >= FPropertyCommentCustomVersion::LazyCommentPayload)
+		{
+			// The payload is decoded after the archive is gone, so remember how it was written
+			PayloadVersion = Ar.CustomVer(FPropertyCommentCustomVersion::GUID);
+			SerializeCommentPayload(Ar);
+		}
+	}
+}
+
+void UPropertyCommentExtension::PostLoad()
+{
+	Super::PostLoad();
+
+	// Extensions saved before edits were undoable lack the flag
+	SetFlags(RF_Transactional);
+	RebuildNodeLookup();
+	MigrateLegacyComments();
+	FPropertyCommentExtensionRegistry::Register(this);
+}
+
+void UPropertyCommentExtension::PostDuplicate(bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+	RebuildNodeLookup();
+	FPropertyCommentExtensionRegistry::Register(this);
+}
+
+void UPropertyCommentExtension::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+	CompactPathNodes();
+}
+
+void UPropertyCommentExtension::BeginDestroy()
+{
+	FPropertyCommentExtensionRegistry::Unregister(this);
+	Super::BeginDestroy();
+}
+
+void UPropertyCommentExtension::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+}
+
+#if WITH_EDITOR
+void UPropertyCommentExtension::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// Only the serialized table comes back, the lookups and counts have to follow it
+	RebuildNodeLookup();
+	NotifyCommentsChanged();
+	if (bStoredInSidecar)
+	{
+		FPropertyCommentSidecar::Save(this);
+	}
+}
+#endif
+
+int32 UPropertyCommentExtension::FindNode(const FPropertyCommentPath& PropertyPath) const
+{
+	INC_DWORD_STAT(STAT_PropertyComment_PathLookups);
+
+	int32 NodeIndex = INDEX_NONE;
+	for (const FPropertyCommentPathSegment& Segment : PropertyPath.Segments)
+	{
+		const int32* Child = NodeLookup.Find({NodeIndex, Segment});
+		if (!Child)
+		{
+			return INDEX_NONE;
+		}
+		NodeIndex = *Child;
+	}
+	return NodeIndex;
+}
+
+int32 UPropertyCommentExtension::FindOrAddNode(const FPropertyCommentPath& PropertyPath)
+{
+	int32 NodeIndex = INDEX_NONE;
+	for (const FPropertyCommentPathSegment& Segment : PropertyPath.Segments)
+	{
+		const TPair<int32, FPropertyCommentPathSegment> Key{NodeIndex, Segment};
+		if (const int32* Child = NodeLookup.Find(Key))
+		{
+			NodeIndex = *Child;
+			continue;
+		}
+
+		FPropertyCommentPathNode& Node = PathNodes.AddDefaulted_GetRef();
+		Node.Segment = Segment;
+		Node.Parent = NodeIndex;
+
+		NodeIndex = PathNodes.Num() - 1;
+		NodeLookup.Add(Key, NodeIndex);
+		NodesByName.Add(Segment.Name, NodeIndex);
+	}
+	return NodeIndex;
+}
+
+void UPropertyCommentExtension::AdjustNumComments(int32 NodeIndex, int32 Delta)
+{
+	for (; PathNodes.IsValidIndex(NodeIndex); NodeIndex = PathNodes[NodeIndex].Parent)
+	{
+		PathNodes[NodeIndex].NumComments += Delta;
+	}
+}
+
+void UPropertyCommentExtension::MigrateLegacyComments()
+{
+	bool bMigrated = false;
+	for (TPair<FName, FText>& Pair : Comments)
+	{
+		const FPropertyCommentPath PropertyPath = FPropertyCommentPath::FromLegacyKey(Pair.Key.ToString());
+		if (!PropertyPath.IsEmpty())
+		{
+			bMigrated |= AddCommentNoNotify(PropertyPath, MoveTemp(Pair.Value));
+		}
+	}
+	Comments.Empty();
+
+	if (bMigrated)
+	{
+		NotifyCommentsChanged();
+	}
+}
+
+void UPropertyCommentExtension::CompactPathNodes()
+{
+	EnsureCommentTextsLoaded();
+
+	// Parents always precede their children, so a single forward pass can remap parent indices
+	TArray<int32> Remap;
+	Remap.Init(INDEX_NONE, PathNodes.Num());
+
+	TArray<FPropertyCommentPathNode> CompactedNodes;
+	TMap<int32, FText> CompactedComments;
+	for (int32 NodeIndex = 0; NodeIndex < PathNodes.Num(); ++NodeIndex)
+	{
+		FPropertyCommentPathNode& Node = PathNodes[NodeIndex];
+		if (Node.NumComments <= 0)
+		{
+			continue;
+		}
+
+		Node.Parent = Node.Parent != INDEX_NONE ? Remap[Node.Parent] : INDEX_NONE;
+		Remap[NodeIndex] = CompactedNodes.Add(Node);
+
+		if (FText* Comment = NodeComments.Find(NodeIndex))
+		{
+			CompactedComments.Emplace(Remap[NodeIndex], MoveTemp(*Comment));
+		}
+	}
+
+	PathNodes = MoveTemp(CompactedNodes);
+	NodeComments = MoveTemp(CompactedComments);
+	RebuildNodeLookup();
+	RebuildSharedTexts();
+}
+
+void UPropertyCommentExtension::NotifyCommentsChanged(const FPropertyCommentPath* ChangedPath)
+{
+	++Revision;
+	++GlobalRevision;
+	OnCommentsChanged().Broadcast(this, ChangedPath);
+}
+
+void UPropertyCommentExtension::EnsureCommentTextsLoaded() const
+{
+	if (PendingTextKeys.Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::LoadCommentTexts);
+
+	// Decoding only fills in the values of existing entries, the set of comments stays the same
+	UPropertyCommentExtension* MutableThis = const_cast<UPropertyCommentExtension*>(this);
+
+	TArray<FText> Texts;
+	{
+		const uint8* Data = static_cast<const uint8*>(MutableThis->CommentPayload.LockReadOnly());
+		FMemoryReaderView Reader{MakeArrayView(Data, static_cast<int32>(MutableThis->CommentPayload.GetBulkDataSize())), true};
+
+		ECommentPayloadFormat Format = ECommentPayloadFormat::Texts;
+		if (PayloadVersion >= FPropertyCommentCustomVersion::CommentPayloadFormat)
+		{
+			Reader << Format;
+		}
+
+		if (Format == ECommentPayloadFormat::StringTable)
+		{
+			TArray<FString> Strings;
+			TArray<int32> StringIndices;
+			Reader << Strings << StringIndices;
+
+			// Every distinct string becomes a single text, shared by all the comments using it
+			TArray<FText> StringTexts;
+			StringTexts.Reserve(Strings.Num());
+			for (FString& String : Strings)
+			{
+				StringTexts.Add(FText::AsCultureInvariant(MoveTemp(String)));
+			}
+
+			Texts.Reserve(StringIndices.Num());
+			for (const int32 StringIndex : StringIndices)
+			{
+				Texts.Add(StringTexts.IsValidIndex(StringIndex) ? StringTexts[StringIndex] : FText::GetEmpty());
+			}
+		}
+		else
+		{
+			Reader << Texts;
+		}
+		MutableThis->CommentPayload.Unlock();
+	}
+
+	for (int32 Index = 0; Index < PendingTextKeys.Num() && Index < Texts.Num(); ++Index)
+	{
+		if (FText* Comment = MutableThis->NodeComments.Find(PendingTextKeys[Index]))
+		{
+			*Comment = MoveTemp(Texts[Index]);
+		}
+	}
+
+	MutableThis->PendingTextKeys.Empty();
+	MutableThis->CommentPayload.RemoveBulkData();
+	MutableThis->RebuildSharedTexts();
+}
+
+void UPropertyCommentExtension::SerializeCommentPayload(FArchive& Ar)
+{
+	if (Ar.IsSaving())
+	{
+		TArray<int32> Keys;
+		NodeComments.GenerateKeyArray(Keys);
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer{Bytes, true};
+
+		ECommentPayloadFormat Format = UseCompactCommentTexts() ? ECommentPayloadFormat::StringTable : ECommentPayloadFormat::Texts;
+		Writer << Format;
+
+		if (Format == ECommentPayloadFormat::StringTable)
+		{
+			TArray<FString> Strings;
+			TArray<int32> StringIndices;
+			TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveStringKeyFuncs> StringToIndex;
+			StringIndices.Reserve(Keys.Num());
+			for (const int32 Key : Keys)
+			{
+				const FString& String = NodeComments[Key].ToString();
+				const int32* Existing = StringToIndex.Find(String);
+				StringIndices.Add(Existing ? *Existing : StringToIndex.Add(String, Strings.Add(String)));
+			}
+			Writer << Strings << StringIndices;
+		}
+		else
+		{
+			TArray<FText> Texts;
+			Texts.Reserve(Keys.Num());
+			for (const int32 Key : Keys)
+			{
+				Texts.Add(NodeComments[Key]);
+			}
+			Writer << Texts;
+		}
+
+		// The linker writes the payload at the end of the package, so it has to stay alive until then
+		CommentPayload.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(CommentPayload.Realloc(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+		CommentPayload.Unlock();
+		CommentPayload.StoreCompressedOnDisk(Bytes.Num() > CompressedPayloadThreshold ? NAME_Zlib : NAME_None);
+
+		Ar << Keys;
+		CommentPayload.Serialize(Ar, this);
+		return;
+	}
+
+	// Only the keys are read now, the payload stays in the package until a text is asked for
+	Ar << PendingTextKeys;
+	CommentPayload.Serialize(Ar, this);
+
+	NodeComments.Reset();
+	NodeComments.Reserve(PendingTextKeys.Num());
+	for (const int32 NodeIndex : PendingTextKeys)
+	{
+		NodeComments.Add(NodeIndex, FText::GetEmpty());
+	}
+}
+
+void UPropertyCommentExtension::EnsureTokenIndexBuilt() const
+{
+	if (bTokenIndexBuilt)
+	{
+		return;
 	}
+
+	EnsureCommentTextsLoaded();
+	TokenIndex.Reset();
+	bTokenIndexBuilt = true;
+	bTokenVocabularyDirty = true;
+	for (const TPair<int32, FText>& Pair : NodeComments)
+	{
+		AddToTokenIndex(Pair.Key, Pair.Value);
+	}
+}
+
+void UPropertyCommentExtension::AddToTokenIndex(int32 NodeIndex, const FText& Comment) const
+{
+	if (!bTokenIndexBuilt)
+	{
+		return;
+	}
+
+	TArray<FString, TInlineAllocator<32>> Tokens;
+	PropertyCommentTokenizer::Tokenize(Comment.ToString(), Tokens);
+	for (FString& Token : Tokens)
+	{
+		TArray<int32>& Nodes = TokenIndex.FindOrAdd(MoveTemp(Token));
+		bTokenVocabularyDirty |= Nodes.Num() == 0;
+
+		// Kept sorted for the merge intersections of FindCommentsMatching
+		const int32 Index = Algo::LowerBound(Nodes, NodeIndex);
+		if (!Nodes.IsValidIndex(Index) || Nodes[Index] != NodeIndex)
+		{
+			Nodes.Insert(NodeIndex, Index);
+		}
+	}
+}
+
+void UPropertyCommentExtension::RemoveFromTokenIndex(int32 NodeIndex, const FText& Comment) const
+{
+	if (!bTokenIndexBuilt)
+	{
+		return;
+	}
+
+	TArray<FString, TInlineAllocator<32>> Tokens;
+	PropertyCommentTokenizer::Tokenize(Comment.ToString(), Tokens);
+	for (const FString& Token : Tokens)
+	{
+		if (TArray<int32>* Nodes = TokenIndex.Find(Token))
+		{
+			const int32 Index = Algo::BinarySearch(*Nodes, NodeIndex);
+			if (Index != INDEX_NONE)
+			{
+				Nodes->RemoveAt(Index, 1, false);
+			}
+			if (Nodes->Num() == 0)
+			{
+				TokenIndex.Remove(Token);
+				bTokenVocabularyDirty = true;
+			}
+		}
+	}
+}
+
+void UPropertyCommentExtension::ResetTokenIndex() const
+{
+	TokenIndex.Empty();
+	TokenVocabulary.Empty();
+	bTokenIndexBuilt = false;
+	bTokenVocabularyDirty = false;
 }
 
-void UPropertyCommentExtension::RemoveComment(const FName& PropertyKey)
+FText UPropertyCommentExtension::ShareCommentText(const FText& Comment)
 {
-	Comments.Remove(PropertyKey);
+	const FString& String = Comment.ToString();
+	if (const FText* Existing = SharedTexts.Find(String))
+	{
+		return *Existing;
+	}
+
+	const FText Shared = Comment.IsCultureInvariant() ? Comment : FText::AsCultureInvariant(String);
+	SharedTexts.Add(Shared);
+	return Shared;
+}
+
+void UPropertyCommentExtension::RebuildSharedTexts()
+{
+	// Drops the strings no comment uses anymore
+	SharedTexts.Reset();
+	if (!UseCompactCommentTexts())
+	{
+		return;
+	}
+
+	for (TPair<int32, FText>& Pair : NodeComments)
+	{
+		Pair.Value = ShareCommentText(Pair.Value);
+	}
+}
+
+bool UPropertyCommentExtension::RenameNode(int32 NodeIndex, FName NewName)
+{
+	FPropertyCommentPathNode& Node = PathNodes[NodeIndex];
+	const FPropertyCommentPathSegment NewSegment{NewName, Node.Segment.ArrayIndex};
+	NodeLookup.Remove({Node.Parent, Node.Segment});
+	NodesByName.RemoveSingle(Node.Segment.Name, NodeIndex);
+	Node.Segment = NewSegment;
+
+	if (const int32* ExistingIndex = NodeLookup.Find({Node.Parent, NewSegment}))
+	{
+		MergeNodes(NodeIndex, *ExistingIndex);
+		return true;
+	}
+
+	NodeLookup.Add({Node.Parent, NewSegment}, NodeIndex);
+	NodesByName.Add(NewName, NodeIndex);
+	return false;
+}
+
+void UPropertyCommentExtension::MergeNodes(int32 RenamedIndex, int32 ExistingIndex)
+{
+	// Parents have to keep preceding their children, so the lower index survives
+	const int32 KeepIndex = FMath::Min(RenamedIndex, ExistingIndex);
+	const int32 DropIndex = FMath::Max(RenamedIndex, ExistingIndex);
+	const FPropertyCommentPathNode Keep = PathNodes[KeepIndex];
+
+	// The renamed comment belongs to the live property, anything already under the new name is stale
+	FText RenamedComment;
+	FText ExistingComment;
+	const bool bHasRenamedComment = NodeComments.RemoveAndCopyValue(RenamedIndex, RenamedComment);
+	const bool bHasExistingComment = NodeComments.RemoveAndCopyValue(ExistingIndex, ExistingComment);
+	if (bHasRenamedComment || bHasExistingComment)
+	{
+		NodeComments.Add(KeepIndex, bHasRenamedComment ? MoveTemp(RenamedComment) : MoveTemp(ExistingComment));
+	}
+
+	// NodesByName is left as is, the compaction following every merge rebuilds it
+	NodeLookup.Add({Keep.Parent, Keep.Segment}, KeepIndex);
+
+	// Merging is rare enough for a scan. Children always come after their parent.
+	for (int32 ChildIndex = DropIndex + 1; ChildIndex < PathNodes.Num(); ++ChildIndex)
+	{
+		FPropertyCommentPathNode& Child = PathNodes[ChildIndex];
+		if (Child.Parent != DropIndex)
+		{
+			continue;
+		}
+
+		NodeLookup.Remove({DropIndex, Child.Segment});
+		Child.Parent = KeepIndex;
+
+		if (const int32* Collision = NodeLookup.Find({KeepIndex, Child.Segment}))
+		{
+			const bool bChildIsRenamed = DropIndex == RenamedIndex;
+			MergeNodes(bChildIsRenamed ? ChildIndex : *Collision, bChildIsRenamed ? *Collision : ChildIndex);
+		}
+		else
+		{
+			NodeLookup.Add({KeepIndex, Child.Segment}, ChildIndex);
+		}
+	}
+}
+
+void UPropertyCommentExtension::RebuildNodeLookup()
+{
+	// Called whenever node indices may have changed
+	ResetTokenIndex();
+
+	NodeLookup.Reset();
+	NodeLookup.Reserve(PathNodes.Num());
+	NodesByName.Reset();
+	for (int32 NodeIndex = 0; NodeIndex < PathNodes.Num(); ++NodeIndex)
+	{
+		const FPropertyCommentPathNode& Node = PathNodes[NodeIndex];
+		NodeLookup.Add({Node.Parent, Node.Segment}, NodeIndex);
+		NodesByName.Add(Node.Segment.Name, NodeIndex);
+	}
+
+	RebuildNumComments();
+}
+
+void UPropertyCommentExtension::RebuildNumComments()
+{
+	for (FPropertyCommentPathNode& Node : PathNodes)
+	{
+		Node.NumComments = 0;
+	}
+
+	for (const TPair<int32, FText>& Pair : NodeComments)
+	{
+		AdjustNumComments(Pair.Key, 1);
+	}
 }
 
 #endif
\ No newline at end of file
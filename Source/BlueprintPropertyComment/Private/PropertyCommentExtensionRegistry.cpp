@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentExtensionRegistry.h"
+#include "PropertyCommentExtension.h"
+#include "Engine/Blueprint.h"
+
+#if WITH_EDITORONLY_DATA
+
+TMap<TWeakObjectPtr<const UBlueprint>, TWeakObjectPtr<UPropertyCommentExtension>> FPropertyCommentExtensionRegistry::Extensions;
+
+void FPropertyCommentExtensionRegistry::Register(UPropertyCommentExtension* Extension)
+{
+	check(IsInGameThread());
+
+	if (!IsValid(Extension) || Extension->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return;
+	}
+
+	if (const UBlueprint* Blueprint = Extension->GetBlueprint())
+	{
+		Extensions.Add(Blueprint, Extension);
+	}
+}
+
+void FPropertyCommentExtensionRegistry::Unregister(UPropertyCommentExtension* Extension)
+{
+	check(IsInGameThread());
+
+	const UBlueprint* Blueprint = Extension ? Extension->GetBlueprint() : nullptr;
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	// Both objects may already be unreachable during GC, so compare by index and serial number
+	const TWeakObjectPtr<const UBlueprint> Key{Blueprint};
+	const TWeakObjectPtr<UPropertyCommentExtension>* FindResult = Extensions.Find(Key);
+	if (FindResult && FindResult->HasSameIndexAndSerialNumber(TWeakObjectPtr<UPropertyCommentExtension>{Extension}))
+	{
+		Extensions.Remove(Key);
+	}
+}
+
+UPropertyCommentExtension* FPropertyCommentExtensionRegistry::Find(const UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	const TWeakObjectPtr<UPropertyCommentExtension>* FindResult = Extensions.Find(Blueprint);
+	if (!FindResult)
+	{
+		return nullptr;
+	}
+
+	UPropertyCommentExtension* Extension = FindResult->Get();
+	return IsValid(Extension) && Extension->GetBlueprint() == Blueprint ? Extension : nullptr;
+}
+
+void FPropertyCommentExtensionRegistry::Reset()
+{
+	Extensions.Reset();
+}
+
+#endif
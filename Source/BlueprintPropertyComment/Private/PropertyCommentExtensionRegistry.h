@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#if WITH_EDITORONLY_DATA
+
+class UBlueprint;
+class UPropertyCommentExtension;
+
+/**
+ * Maps every blueprint to its comment extension so that lookups do not have to scan
+ * UBlueprint::Extensions. Extensions register themselves when they are loaded, duplicated
+ * or created, and unregister when they are destroyed.
+ */
+class FPropertyCommentExtensionRegistry
+{
+public:
+	static void Register(UPropertyCommentExtension* Extension);
+	static void Unregister(UPropertyCommentExtension* Extension);
+	static UPropertyCommentExtension* Find(const UBlueprint* Blueprint);
+	static void Reset();
+
+private:
+	static TMap<TWeakObjectPtr<const UBlueprint>, TWeakObjectPtr<UPropertyCommentExtension>> Extensions;
+};
+
+#endif
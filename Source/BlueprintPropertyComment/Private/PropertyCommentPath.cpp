@@ -0,0 +1,180 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentPath.h"
+#include "PropertyCommentStats.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	bool ParseSegment(FStringView Token, FPropertyCommentPathSegment& OutSegment)
+	{
+		int32 ArrayIndex = INDEX_NONE;
+
+		int32 BracketIndex = INDEX_NONE;
+		if (Token.EndsWith(TEXT(']')) && Token.FindChar(TEXT('['), BracketIndex))
+		{
+			const FStringView IndexView = Token.Mid(BracketIndex + 1, Token.Len() - BracketIndex - 2);
+			LexFromString(ArrayIndex, *FString{IndexView});
+			Token = Token.Left(BracketIndex);
+		}
+
+		if (Token.IsEmpty())
+		{
+			return false;
+		}
+
+#if STATS
+		const int32 NumNamesBefore = FName::GetNumAnsiNames() + FName::GetNumWideNames();
+#endif
+		OutSegment = FPropertyCommentPathSegment{FName{Token.Len(), Token.GetData()}, ArrayIndex};
+#if STATS
+		INC_DWORD_STAT_BY(STAT_PropertyComment_NamesCreated, FName::GetNumAnsiNames() + FName::GetNumWideNames() - NumNamesBefore);
+#endif
+		return true;
+	}
+
+	const FProperty* GetElementProperty(const FProperty* Container, FName ElementName)
+	{
+		const FProperty* Element = nullptr;
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Container))
+		{
+			Element = ArrayProperty->Inner;
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Container))
+		{
+			Element = SetProperty->ElementProp;
+		}
+		else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Container))
+		{
+			Element = MapProperty->ValueProp;
+		}
+		else if (Container->ArrayDim > 1)
+		{
+			// Elements of fixed size arrays are shown through the array property itself
+			Element = Container;
+		}
+
+		// Element handles report either the container name or the inner property name
+		const bool bNameMatches = Element && (ElementName == Container->GetFName() || ElementName == Element->GetFName());
+		return bNameMatches ? Element : nullptr;
+	}
+
+	const UStruct* GetPropertyScope(const FProperty* Property)
+	{
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			return StructProperty->Struct;
+		}
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			return ObjectProperty->PropertyClass;
+		}
+		return nullptr;
+	}
+
+	template <typename AllocatorType>
+	void ParseSegments(FStringView InString, TArray<FPropertyCommentPathSegment, AllocatorType>& OutSegments)
+	{
+		while (!InString.IsEmpty())
+		{
+			int32 DotIndex = INDEX_NONE;
+			const FStringView Token = InString.FindChar(TEXT('.'), DotIndex) ? InString.Left(DotIndex) : InString;
+			InString.RightChopInline(DotIndex == INDEX_NONE ? InString.Len() : DotIndex + 1);
+
+			if (FPropertyCommentPathSegment Segment; ParseSegment(Token, Segment))
+			{
+				OutSegments.Add(Segment);
+			}
+		}
+	}
+}
+
+FPropertyCommentPath FPropertyCommentPath::FromString(FStringView InString)
+{
+	FPropertyCommentPath Path;
+	ParseSegments(InString, Path.Segments);
+	return Path;
+}
+
+FPropertyCommentPath FPropertyCommentPath::FromLegacyKey(FStringView InLegacyKey)
+{
+	static constexpr FStringView Separator = TEXTVIEW("->");
+
+	// Each "->" component is the full path of one handle in the parent chain. Usually a component
+	// extends the previous one, but the path restarts when crossing into an instanced object.
+	FPropertyCommentPath Path;
+	TArray<FPropertyCommentPathSegment, TInlineAllocator<8>> Previous;
+
+	while (!InLegacyKey.IsEmpty())
+	{
+		const int32 SeparatorIndex = InLegacyKey.Find(Separator);
+		const FStringView Component = SeparatorIndex == INDEX_NONE ? InLegacyKey : InLegacyKey.Left(SeparatorIndex);
+		InLegacyKey.RightChopInline(SeparatorIndex == INDEX_NONE ? InLegacyKey.Len() : SeparatorIndex + Separator.Len());
+
+		TArray<FPropertyCommentPathSegment, TInlineAllocator<8>> Current;
+		ParseSegments(Component, Current);
+
+		int32 NumShared = 0;
+		if (Previous.Num() <= Current.Num())
+		{
+			while (NumShared < Previous.Num() && Previous[NumShared] == Current[NumShared])
+			{
+				++NumShared;
+			}
+			NumShared = NumShared == Previous.Num() ? NumShared : 0;
+		}
+
+		Path.Segments.Append(Current.GetData() + NumShared, Current.Num() - NumShared);
+		Previous = MoveTemp(Current);
+	}
+
+	return Path;
+}
+
+const FProperty* FPropertyCommentPath::Resolve(const UStruct* Root) const
+{
+	const FProperty* Current = nullptr;
+	for (const FPropertyCommentPathSegment& Segment : Segments)
+	{
+		if (Current && Segment.ArrayIndex != INDEX_NONE)
+		{
+			if (const FProperty* Element = GetElementProperty(Current, Segment.Name))
+			{
+				if (Element == Current && Segment.ArrayIndex >= Current->ArrayDim)
+				{
+					return nullptr;
+				}
+
+				Current = Element;
+				continue;
+			}
+		}
+
+		const UStruct* Scope = Current ? GetPropertyScope(Current) : Root;
+		Current = Scope ? FindFProperty<FProperty>(Scope, Segment.Name) : nullptr;
+		if (!Current)
+		{
+			return nullptr;
+		}
+	}
+	return Current;
+}
+
+FString FPropertyCommentPath::ToString() const
+{
+	TStringBuilder<256> Builder;
+	for (const FPropertyCommentPathSegment& Segment : Segments)
+	{
+		if (Builder.Len() > 0)
+		{
+			Builder << TEXT('.');
+		}
+
+		Builder << Segment.Name;
+		if (Segment.ArrayIndex != INDEX_NONE)
+		{
+			Builder << TEXT('[') << Segment.ArrayIndex << TEXT(']');
+		}
+	}
+	return FString{Builder.ToView()};
+}
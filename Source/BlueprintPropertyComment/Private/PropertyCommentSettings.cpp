@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentSettings.h"
+#include "PropertyCommentSidecar.h"
+#include "Misc/Paths.h"
+
+UPropertyCommentSettings::UPropertyCommentSettings()
+{
+	SidecarDirectory.Path = TEXT("PropertyComments");
+}
+
+FString UPropertyCommentSettings::GetSidecarDirectory() const
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), SidecarDirectory.Path);
+}
+
+FName UPropertyCommentSettings::GetCategoryName() const
+{
+	return TEXT("Plugins");
+}
+
+#if WITH_EDITOR
+void UPropertyCommentSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// The directory may have changed, list it again on next use
+	FPropertyCommentSidecar::Reset();
+}
+#endif
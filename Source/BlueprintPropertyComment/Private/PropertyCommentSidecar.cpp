@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentSidecar.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentExtensionRegistry.h"
+#include "PropertyCommentSettings.h"
+#include "PropertyCommentTextEscape.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/GCObject.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITORONLY_DATA
+
+namespace
+{
+	const TCHAR* SidecarHeader = TEXT("# PropertyComments sidecar v1");
+
+	// Files written before the blueprint path was recorded lack this line until their next change
+	const TCHAR* SidecarBlueprintPrefix = TEXT("# Blueprint\t");
+	const TCHAR* SidecarExtension = TEXT(".txt");
+}
+
+/**
+ * Nothing but the registry, which only holds weak pointers, refers to a sidecar extension. The
+ * extensions are referenced here instead, and released after garbage collection destroyed their blueprint.
+ */
+class FPropertyCommentSidecar::FExtensionReferences final : public FGCObject
+{
+public:
+	FExtensionReferences()
+	{
+		PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FExtensionReferences::ReleaseOrphans);
+	}
+
+	virtual ~FExtensionReferences() override
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	}
+
+	void Add(const UBlueprint* Blueprint, UPropertyCommentExtension* Extension)
+	{
+		Extensions.Add(Blueprint, Extension);
+	}
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		for (TPair<TWeakObjectPtr<const UBlueprint>, TObjectPtr<UPropertyCommentExtension>>& Pair : Extensions)
+		{
+			Collector.AddReferencedObject(Pair.Value);
+		}
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FPropertyCommentSidecar");
+	}
+	//~ End FGCObject Interface
+
+private:
+	void ReleaseOrphans()
+	{
+		// Weak pointers are only reliable outside of reachability analysis, so stale blueprints are pruned afterwards
+		for (auto It = Extensions.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	TMap<TWeakObjectPtr<const UBlueprint>, TObjectPtr<UPropertyCommentExtension>> Extensions;
+	FDelegateHandle PostGarbageCollectHandle;
+};
+
+TOptional<TSet<FGuid>> FPropertyCommentSidecar::KnownFiles;
+TOptional<TMap<FGuid, FSoftObjectPath>> FPropertyCommentSidecar::KnownBlueprints;
+TUniquePtr<FPropertyCommentSidecar::FExtensionReferences> FPropertyCommentSidecar::ExtensionReferences;
+
+bool FPropertyCommentSidecar::IsEnabled()
+{
+	return GetDefault<UPropertyCommentSettings>()->Storage == EPropertyCommentStorage::Sidecar;
+}
+
+UPropertyCommentExtension* FPropertyCommentSidecar::Load(const UBlueprint* Blueprint)
+{
+	// Most blueprints have no comments at all, so this has to stay a set lookup for them
+	if (!Blueprint->BlueprintGuid.IsValid() || !GetKnownFiles().Contains(Blueprint->BlueprintGuid))
+	{
+		return nullptr;
+	}
+
+	UPropertyCommentExtension* Extension = Create(const_cast<UBlueprint*>(Blueprint));
+	bool bLoadedAny = false;
+	FFileHelper::LoadFileToStringWithLineVisitor(*GetFilename(Blueprint), [Extension, &bLoadedAny](FStringView Line)
+	{
+		int32 TabIndex = INDEX_NONE;
+		if (Line.StartsWith(TEXT('#')) || !Line.FindChar(TEXT('\t'), TabIndex))
+		{
+			return;
+		}
+
+		const FPropertyCommentPath PropertyPath = FPropertyCommentPath::FromString(Line.Left(TabIndex));
+		if (!PropertyPath.IsEmpty())
+		{
+			bLoadedAny |= Extension->AddCommentNoNotify(PropertyPath, FText::FromString(PropertyCommentTextEscape::Unescape(Line.RightChop(TabIndex + 1))));
+		}
+	});
+
+	// Listeners see the file once it is fully read, not once per line
+	if (bLoadedAny)
+	{
+		Extension->NotifyCommentsChanged();
+	}
+	return Extension;
+}
+
+UPropertyCommentExtension* FPropertyCommentSidecar::Create(UBlueprint* Blueprint)
+{
+	// Outside of the blueprint, an inner would keep its outer alive through the reference held below
+	UPropertyCommentExtension* Extension = NewObject<UPropertyCommentExtension>(GetTransientPackage(), NAME_None, RF_Transient | RF_Transactional);
+	Extension->bStoredInSidecar = true;
+	Extension->SidecarBlueprint = Blueprint;
+	FPropertyCommentExtensionRegistry::Register(Extension);
+
+	if (!ExtensionReferences)
+	{
+		ExtensionReferences = MakeUnique<FExtensionReferences>();
+	}
+	ExtensionReferences->Add(Blueprint, Extension);
+	return Extension;
+}
+
+bool FPropertyCommentSidecar::Save(const UPropertyCommentExtension* Extension)
+{
+	const UBlueprint* Blueprint = Extension->GetBlueprint();
+	if (!Blueprint || !Blueprint->BlueprintGuid.IsValid())
+	{
+		return false;
+	}
+
+	const FString Filename = GetFilename(Blueprint);
+	if (IFileManager::Get().FileExists(*Filename) && IFileManager::Get().IsReadOnly(*Filename))
+	{
+		UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Cannot save the comments of %s, %s is read only. Check it out and edit the comment again."),
+			*Blueprint->GetPathName(), *Filename);
+		return false;
+	}
+
+	if (Extension->GetNumComments() == 0)
+	{
+		GetKnownFiles().Remove(Blueprint->BlueprintGuid);
+		if (KnownBlueprints.IsSet())
+		{
+			KnownBlueprints->Remove(Blueprint->BlueprintGuid);
+		}
+		return !IFileManager::Get().FileExists(*Filename) || IFileManager::Get().Delete(*Filename);
+	}
+
+	// Sorted, so that the files diff and merge cleanly
+	TArray<FString> Lines;
+	Lines.Reserve(Extension->GetNumComments());
+	Extension->ForEachComment([&Lines](const FPropertyCommentPath& PropertyPath, const FText& Comment)
+	{
+		Lines.Add(PropertyPath.ToString() + TEXT('\t') + PropertyCommentTextEscape::Escape(Comment.ToString()));
+	});
+	Lines.Sort();
+	Lines.Insert(SidecarBlueprintPrefix + Blueprint->GetPathName(), 0);
+	Lines.Insert(SidecarHeader, 0);
+	Lines.Add(FString{});
+
+	if (!FFileHelper::SaveStringToFile(FString::Join(Lines, TEXT("\n")), *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Could not write the comments of %s to %s"), *Blueprint->GetPathName(), *Filename);
+		return false;
+	}
+
+	GetKnownFiles().Add(Blueprint->BlueprintGuid);
+	if (KnownBlueprints.IsSet())
+	{
+		KnownBlueprints->Add(Blueprint->BlueprintGuid, FSoftObjectPath{Blueprint});
+	}
+	return true;
+}
+
+void FPropertyCommentSidecar::GetBlueprints(TArray<FSoftObjectPath>& OutBlueprints)
+{
+	if (!KnownBlueprints.IsSet())
+	{
+		TMap<FGuid, FSoftObjectPath>& Blueprints = KnownBlueprints.Emplace();
+		const FString Directory = GetDefault<UPropertyCommentSettings>()->GetSidecarDirectory();
+		for (const FGuid& Guid : GetKnownFiles())
+		{
+			// The path is on the second line, the comments below it are not needed here
+			const FString Filename = Directory / Guid.ToString(EGuidFormats::Digits) + SidecarExtension;
+			TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*Filename)};
+			if (!Reader)
+			{
+				continue;
+			}
+
+			TArray<ANSICHAR> Bytes;
+			Bytes.SetNumUninitialized(FMath::Min<int64>(Reader->TotalSize(), 1024));
+			Reader->Serialize(Bytes.GetData(), Bytes.Num());
+			const FUTF8ToTCHAR Header{Bytes.GetData(), Bytes.Num()};
+
+			TArray<FString> HeaderLines;
+			FString{Header.Length(), Header.Get()}.ParseIntoArrayLines(HeaderLines);
+			if (HeaderLines.Num() > 1 && HeaderLines[1].StartsWith(SidecarBlueprintPrefix, ESearchCase::CaseSensitive))
+			{
+				Blueprints.Add(Guid, FSoftObjectPath{HeaderLines[1].RightChop(FCString::Strlen(SidecarBlueprintPrefix))});
+			}
+		}
+	}
+
+	KnownBlueprints->GenerateValueArray(OutBlueprints);
+}
+
+void FPropertyCommentSidecar::Reset()
+{
+	KnownFiles.Reset();
+	KnownBlueprints.Reset();
+}
+
+void FPropertyCommentSidecar::Shutdown()
+{
+	KnownFiles.Reset();
+	KnownBlueprints.Reset();
+	ExtensionReferences.Reset();
+}
+
+FString FPropertyCommentSidecar::GetFilename(const UBlueprint* Blueprint)
+{
+	return GetDefault<UPropertyCommentSettings>()->GetSidecarDirectory() / Blueprint->BlueprintGuid.ToString(EGuidFormats::Digits) + SidecarExtension;
+}
+
+TSet<FGuid>& FPropertyCommentSidecar::GetKnownFiles()
+{
+	if (!KnownFiles.IsSet())
+	{
+		TSet<FGuid>& Guids = KnownFiles.Emplace();
+
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *(GetDefault<UPropertyCommentSettings>()->GetSidecarDirectory() / TEXT("*") + SidecarExtension), true, false);
+		for (const FString& File : Files)
+		{
+			FGuid Guid;
+			if (FGuid::Parse(FPaths::GetBaseFilename(File), Guid))
+			{
+				Guids.Add(Guid);
+			}
+		}
+	}
+	return KnownFiles.GetValue();
+}
+
+#endif
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITORONLY_DATA
+
+class UBlueprint;
+class UPropertyCommentExtension;
+
+/**
+ * Stores comments outside of the blueprint package, in one UTF-8 text file per blueprint named
+ * after UBlueprint::BlueprintGuid. The directory is listed once; a file is only read the first
+ * time its blueprint is asked for comments, and rewritten whenever one of them changes. The header
+ * of each file records the path of its blueprint, so that tools can find commented blueprints
+ * without loading them.
+ *
+ * Extensions backed by a sidecar file are transient and never added to UBlueprint::Extensions.
+ * They live in the transient package and are kept alive here until their blueprint is destroyed.
+ */
+class FPropertyCommentSidecar
+{
+public:
+	static bool IsEnabled();
+
+	/** Creates a transient extension holding the sidecar comments of the blueprint, or returns null if it has none. */
+	static UPropertyCommentExtension* Load(const UBlueprint* Blueprint);
+
+	/** Creates an empty transient extension, written to a sidecar file once it gets comments. */
+	static UPropertyCommentExtension* Create(UBlueprint* Blueprint);
+
+	/** Writes the comments of the extension, or deletes the file when there are none left. */
+	static bool Save(const UPropertyCommentExtension* Extension);
+
+	/** Blueprints named in the headers of the sidecar files. Files are read on the first call. */
+	static void GetBlueprints(TArray<FSoftObjectPath>& OutBlueprints);
+
+	static void Reset();
+
+	/** Releases every extension, on module shutdown. */
+	static void Shutdown();
+
+private:
+	static FString GetFilename(const UBlueprint* Blueprint);
+	static TSet<FGuid>& GetKnownFiles();
+
+	static TOptional<TSet<FGuid>> KnownFiles;
+	static TOptional<TMap<FGuid, FSoftObjectPath>> KnownBlueprints;
+
+	class FExtensionReferences;
+	static TUniquePtr<FExtensionReferences> ExtensionReferences;
+};
+
+#endif
@@ -0,0 +1,38 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentSnapshot.h"
+
+FPropertyCommentSnapshot::FPropertyCommentSnapshot(const FSoftObjectPath& InBlueprint, uint32 InRevision, TMap<FPropertyCommentPath, FString>&& InComments)
+	: Blueprint(InBlueprint)
+	, Revision(InRevision)
+	, Comments(MoveTemp(InComments))
+{
+}
+
+const FSoftObjectPath& FPropertyCommentSnapshot::GetBlueprint() const
+{
+	return Blueprint;
+}
+
+uint32 FPropertyCommentSnapshot::GetRevision() const
+{
+	return Revision;
+}
+
+int32 FPropertyCommentSnapshot::GetNumComments() const
+{
+	return Comments.Num();
+}
+
+const FString* FPropertyCommentSnapshot::FindComment(const FPropertyCommentPath& PropertyPath) const
+{
+	return Comments.Find(PropertyPath);
+}
+
+void FPropertyCommentSnapshot::ForEachComment(TFunctionRef<void(const FPropertyCommentPath&, const FString&)> Callback) const
+{
+	for (const TPair<FPropertyCommentPath, FString>& Pair : Comments)
+	{
+		Callback(Pair.Key, Pair.Value);
+	}
+}
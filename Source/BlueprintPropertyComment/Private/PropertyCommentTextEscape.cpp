@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentTextEscape.h"
+
+FString PropertyCommentTextEscape::Escape(const FString& Text)
+{
+	FString Escaped;
+	Escaped.Reserve(Text.Len());
+	for (const TCHAR Char : Text)
+	{
+		switch (Char)
+		{
+		case TEXT('\\'): Escaped += TEXT("\\\\"); break;
+		case TEXT('\t'): Escaped += TEXT("\\t"); break;
+		case TEXT('\n'): Escaped += TEXT("\\n"); break;
+		case TEXT('\r'): Escaped += TEXT("\\r"); break;
+		default: Escaped.AppendChar(Char); break;
+		}
+	}
+	return Escaped;
+}
+
+FString PropertyCommentTextEscape::Unescape(FStringView Text)
+{
+	FString Unescaped;
+	Unescaped.Reserve(Text.Len());
+	for (int32 Index = 0; Index < Text.Len(); ++Index)
+	{
+		TCHAR Char = Text[Index];
+		if (Char == TEXT('\\') && Index + 1 < Text.Len())
+		{
+			switch (Text[++Index])
+			{
+			case TEXT('t'): Char = TEXT('\t'); break;
+			case TEXT('n'): Char = TEXT('\n'); break;
+			case TEXT('r'): Char = TEXT('\r'); break;
+			default: Char = Text[Index]; break;
+			}
+		}
+		Unescaped.AppendChar(Char);
+	}
+	return Unescaped;
+}
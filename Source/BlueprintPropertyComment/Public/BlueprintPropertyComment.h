@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+BLUEPRINTPROPERTYCOMMENT_API DECLARE_LOG_CATEGORY_EXTERN(LogBlueprintPropertyComment, Log, All);
+
 class FBlueprintPropertyCommentModule : public IModuleInterface
 {
 	virtual void StartupModule() override;
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+struct FPropertyCommentPath;
+
+/**
+ * Asset registry tags written on blueprints that carry property comments, so that tools can
+ * find commented blueprints without loading them. Blueprints saved before these tags existed
+ * only report them after their next save, until then whether they have comments is unknown.
+ */
+namespace PropertyCommentAssetTags
+{
+	/** Number of comments on the blueprint, 0 included. */
+	BLUEPRINTPROPERTYCOMMENT_API extern const FName CommentCountTag;
+
+	/** Sorted, concatenated 8 digit hex hashes of every commented path. */
+	BLUEPRINTPROPERTYCOMMENT_API extern const FName CommentDigestTag;
+
+	BLUEPRINTPROPERTYCOMMENT_API int32 GetCommentCount(const FAssetData& AssetData);
+
+	/** False for blueprints saved before the tags existed, whose comments are only known once loaded. */
+	BLUEPRINTPROPERTYCOMMENT_API bool HasCommentCount(const FAssetData& AssetData);
+	BLUEPRINTPROPERTYCOMMENT_API bool HasCommentOnPath(const FAssetData& AssetData, const FPropertyCommentPath& PropertyPath);
+
+	/** Case-insensitive hash of the path string, stable across editor sessions unlike FName based hashes. */
+	BLUEPRINTPROPERTYCOMMENT_API uint32 GetStablePathHash(const FPropertyCommentPath& PropertyPath);
+
+#if WITH_EDITORONLY_DATA
+	void Register();
+	void Unregister();
+#endif
+}
@@ -4,8 +4,50 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/BlueprintExtension.h"
+#include "PropertyCommentPath.h"
+#include "PropertyCommentSnapshot.h"
+#include "Serialization/BulkData.h"
 #include "PropertyCommentExtension.generated.h"
 
+class UBlueprint;
+
+/**
+ * Node of the path table. Every node stores a single segment and the index of its parent node,
+ * so paths sharing a prefix share nodes.
+ */
+USTRUCT()
+struct BLUEPRINTPROPERTYCOMMENT_API FPropertyCommentPathNode
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FPropertyCommentPathSegment Segment;
+
+	UPROPERTY()
+	int32 Parent = INDEX_NONE;
+
+	/** Number of comments on this node and all of its descendants. Rebuilt on load. */
+	int32 NumComments = 0;
+};
+
+/** The changed path is null when several comments may have changed at once, after a rename, an undo or a load. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPropertyCommentsChanged, class UPropertyCommentExtension*, const FPropertyCommentPath* /*ChangedPath*/);
+
+/** A property of a blueprint, as given to the batch comment functions. */
+struct FPropertyCommentTarget
+{
+	UBlueprint* Blueprint = nullptr;
+	FPropertyCommentPath PropertyPath;
+};
+
+enum class EPropertyCommentRenameScope : uint8
+{
+	/** Only the outermost segment, e.g. a blueprint member variable. */
+	TopLevel,
+	/** Any segment below the outermost one, e.g. a user defined struct member. */
+	Nested,
+};
+
 /**
  * 
  */
@@ -18,16 +60,188 @@ class BLUEPRINTPROPERTYCOMMENT_API UPropertyCommentExtension final : public UBlu
 public:
 	static UPropertyCommentExtension* GetPropertyCommentExtension(const UBlueprint* Blueprint);
 	static UPropertyCommentExtension* GetOrCreatePropertyCommentExtension(UBlueprint* Blueprint);
-	static void TryAddPropertyComment(UBlueprint* Blueprint, const FName& PropertyKey, FText Comment);
-	static void TryRemovePropertyComment(UBlueprint* Blueprint, const FName& PropertyKey);
 
-	bool HasComment(const FName& PropertyKey) const;
-	bool GetComment(const FName& PropertyKey, FText& OutComment) const;
-	void AddComment(const FName& PropertyKey, FText Comment);
-	void RemoveComment(const FName& PropertyKey);
+	/**
+	 * Blueprints with comments in sidecar files, as recorded in the files. Those blueprints may lack
+	 * the comment asset registry tags, which are only written when the package is saved. Empty unless
+	 * sidecar storage is enabled.
+	 */
+	static void GetSidecarBlueprints(TArray<FSoftObjectPath>& OutBlueprints);
+	static void TryAddPropertyComment(UBlueprint* Blueprint, const FPropertyCommentPath& PropertyPath, FText Comment);
+	static void TryRemovePropertyComment(UBlueprint* Blueprint, const FPropertyCommentPath& PropertyPath);
+
+	/**
+	 * Sets the same comment on every target, which may span many blueprints and properties. Each
+	 * extension is recorded once in the active transaction, if any, and persisted once no matter how
+	 * many of the targets it holds. Returns the number of comments set.
+	 */
+	static int32 TryAddPropertyComments(TConstArrayView<FPropertyCommentTarget> Targets, const FText& Comment);
+	static int32 TryRemovePropertyComments(TConstArrayView<FPropertyCommentTarget> Targets);
+
+	bool HasComment(const FPropertyCommentPath& PropertyPath) const;
+	bool GetComment(const FPropertyCommentPath& PropertyPath, FText& OutComment) const;
+
+	/** Returns the comment without copying it, or null. Only valid until the comments change. */
+	const FText* FindComment(const FPropertyCommentPath& PropertyPath) const;
+	void AddComment(const FPropertyCommentPath& PropertyPath, FText Comment);
+	void RemoveComment(const FPropertyCommentPath& PropertyPath);
+
+	/**
+	 * Persists changes made through AddComment, RemoveComment or RenameProperty: rewrites the
+	 * sidecar file right away, or marks the blueprint package dirty. Returns false if the sidecar
+	 * file could not be written.
+	 */
+	bool MarkCommentsDirty();
+
+	/** True when the comments live in a sidecar file instead of the blueprint package. */
+	bool IsStoredInSidecar() const;
+
+	/** Blueprint the comments belong to. Use this rather than the outer, which is the transient package for sidecar extensions. */
+	UBlueprint* GetBlueprint() const;
+
+	/** Number of comments on properties nested below the given path, not counting the path itself. */
+	int32 GetNumCommentsBelow(const FPropertyCommentPath& PropertyPath) const;
+	int32 GetNumComments() const;
+
+	FPropertyCommentPath GetPathFromNode(int32 NodeIndex) const;
+	void ForEachComment(TFunctionRef<void(const FPropertyCommentPath&, const FText&)> Callback) const;
+
+	/** Like ForEachComment, but without the texts, so it never has to load them. */
+	void ForEachCommentedPath(TFunctionRef<void(const FPropertyCommentPath&)> Callback) const;
+
+	/**
+	 * Paths of the comments containing every word of the query, the last word also matching as a
+	 * prefix while it is being typed, that is unless the query ends with whitespace. Words are folded
+	 * by PropertyCommentTokenizer and looked up in a token index built on first use and kept current
+	 * by AddComment and RemoveComment.
+	 */
+	void FindCommentsMatching(FStringView Query, TArray<FPropertyCommentPath>& OutPaths) const;
+
+	/**
+	 * Renames every path segment matching OldName within the given scope, together with the
+	 * container element segments directly below it. Only nodes carrying OldName are visited.
+	 * Returns the number of comments whose path changed.
+	 */
+	int32 RenameProperty(FName OldName, FName NewName, EPropertyCommentRenameScope Scope);
+
+	/**
+	 * Immutable copy of the comments that may be handed to other threads. Taken again on the first
+	 * request after the comments changed; snapshots handed out earlier stay valid and unchanged.
+	 * Game thread only.
+	 */
+	FPropertyCommentSnapshotRef GetSnapshot() const;
+
+	/** Incremented every time a comment of this extension is added, changed or removed. */
+	uint32 GetRevision() const;
+
+	/** Incremented every time any extension changes. Cheap way for UI to know whether cached values are still current. */
+	static uint32 GetGlobalRevision();
+
+	/** Broadcast after a comment has been added, changed or removed. */
+	static FOnPropertyCommentsChanged& OnCommentsChanged();
+
+	/** Heap memory held by the comments and the path table, including the transient lookups. */
+	SIZE_T GetAllocatedSize() const;
+
+	//~ Begin UObject Interface
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+	virtual void BeginDestroy() override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+#if WITH_EDITOR
+	virtual void PostEditUndo() override;
+#endif
+	//~ End UObject Interface
 
 protected:
+	friend class FPropertyCommentSidecar;
+
+	int32 FindNode(const FPropertyCommentPath& PropertyPath) const;
+	int32 FindOrAddNode(const FPropertyCommentPath& PropertyPath);
+
+	/** AddComment without the notification, for bulk fills that notify once at the end. Returns false if the path was rejected. */
+	bool AddCommentNoNotify(const FPropertyCommentPath& PropertyPath, FText Comment);
+	void AdjustNumComments(int32 NodeIndex, int32 Delta);
+	void MigrateLegacyComments();
+	void CompactPathNodes();
+	void RebuildNodeLookup();
+	void RebuildNumComments();
+	bool RenameNode(int32 NodeIndex, FName NewName);
+	void MergeNodes(int32 RenamedIndex, int32 ExistingIndex);
+	void NotifyCommentsChanged(const FPropertyCommentPath* ChangedPath = nullptr);
+
+	/** Decodes the comment texts if they are still waiting in the payload read from the package. */
+	void EnsureCommentTextsLoaded() const;
+	void SerializeCommentPayload(FArchive& Ar);
+
+	void EnsureTokenIndexBuilt() const;
+	void AddToTokenIndex(int32 NodeIndex, const FText& Comment) const;
+	void RemoveFromTokenIndex(int32 NodeIndex, const FText& Comment) const;
+	void ResetTokenIndex() const;
+
+	/** With compact comment texts enabled, returns the culture-invariant text shared by all identical comments. */
+	FText ShareCommentText(const FText& Comment);
+	void RebuildSharedTexts();
+
+	/** Compares the strings of the texts, case sensitive. */
+	struct FSharedTextKeyFuncs : BaseKeyFuncs<FText, FString>
+	{
+		static const FString& GetSetKey(const FText& Element) { return Element.ToString(); }
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	/** Flat "->"-joined keys written by older versions. Migrated into the path table on load. */
 	UPROPERTY()
 	TMap<FName, FText> Comments;
+
+	UPROPERTY()
+	TArray<FPropertyCommentPathNode> PathNodes;
+
+	/**
+	 * Node -> comment. Packages store the keys and the texts separately: the keys are read on load,
+	 * so which properties have comments is known right away, while the texts stay in CommentPayload
+	 * until something asks for one. Until then the values are empty placeholders.
+	 */
+	UPROPERTY()
+	TMap<int32, FText> NodeComments;
+
+	/** Texts of the PendingTextKeys nodes, in the same order. Loaded from the package on first access. */
+	FByteBulkData CommentPayload;
+	TArray<int32> PendingTextKeys;
+	int32 PayloadVersion = 0;
+
+	/** One text per distinct comment string, when compact comment texts are enabled. */
+	TSet<FText, FSharedTextKeyFuncs> SharedTexts;
+
+	/** (Parent node, segment) -> child node. */
+	TMap<TPair<int32, FPropertyCommentPathSegment>, int32> NodeLookup;
+
+	/** Segment name -> nodes carrying it, so renames only touch the affected nodes. */
+	TMultiMap<FName, int32> NodesByName;
+
+	/**
+	 * Folded token -> sorted nodes whose comment contains it. Only built once something filters by
+	 * comment text, then updated with each added or removed comment. Node indices change when the
+	 * table is compacted, which drops the index until the next query.
+	 */
+	mutable TMap<FString, TArray<int32>> TokenIndex;
+
+	/** Sorted keys of TokenIndex for prefix lookups, sorted again by the first query after tokens came or went. */
+	mutable TArray<FString> TokenVocabulary;
+	mutable bool bTokenIndexBuilt = false;
+	mutable bool bTokenVocabularyDirty = false;
+
+	/** Latest snapshot handed out, reused until the revision moves on. */
+	mutable TSharedPtr<const FPropertyCommentSnapshot, ESPMode::ThreadSafe> Snapshot;
+
+	bool bStoredInSidecar = false;
+
+	/** Owner of a sidecar extension, held weakly so that the extension does not keep it loaded. */
+	TWeakObjectPtr<UBlueprint> SidecarBlueprint;
+	uint32 Revision = 0;
+	static uint32 GlobalRevision;
 #endif
-};
\ No newline at end of file
+};
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PropertyCommentPath.generated.h"
+
+/**
+ * One step of a property path: the property name plus, for container elements, the element index.
+ */
+USTRUCT()
+struct BLUEPRINTPROPERTYCOMMENT_API FPropertyCommentPathSegment
+{
+	GENERATED_BODY()
+
+	FPropertyCommentPathSegment() = default;
+	FPropertyCommentPathSegment(FName InName, int32 InArrayIndex = INDEX_NONE)
+		: Name(InName)
+		, ArrayIndex(InArrayIndex)
+	{
+	}
+
+	UPROPERTY()
+	FName Name;
+
+	UPROPERTY()
+	int32 ArrayIndex = INDEX_NONE;
+
+	bool operator==(const FPropertyCommentPathSegment& Other) const
+	{
+		return Name == Other.Name && ArrayIndex == Other.ArrayIndex;
+	}
+
+	bool operator!=(const FPropertyCommentPathSegment& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FPropertyCommentPathSegment& Segment)
+	{
+		return HashCombine(GetTypeHash(Segment.Name), GetTypeHash(Segment.ArrayIndex));
+	}
+};
+
+/**
+ * Structured key identifying a property shown in the details panel, from the outermost
+ * property down to the commented one. Segment names are the property names themselves,
+ * so building a key never adds entries to the name table.
+ */
+struct BLUEPRINTPROPERTYCOMMENT_API FPropertyCommentPath
+{
+	TArray<FPropertyCommentPathSegment, TInlineAllocator<8>> Segments;
+
+	/** Parses the "Struct.Array[2].Member" form produced by ToString. */
+	static FPropertyCommentPath FromString(FStringView InString);
+
+	/** Parses the "->"-joined keys written by older versions of the plugin. */
+	static FPropertyCommentPath FromLegacyKey(FStringView InLegacyKey);
+
+	FString ToString() const;
+
+	/**
+	 * Follows the path through the property layout of the given struct or class, stepping into
+	 * struct members, instanced object classes and container elements.
+	 * Returns the property the path points at, or null if the path no longer matches the layout.
+	 */
+	const FProperty* Resolve(const UStruct* Root) const;
+
+	bool IsEmpty() const
+	{
+		return Segments.Num() == 0;
+	}
+
+	bool operator==(const FPropertyCommentPath& Other) const
+	{
+		return Segments == Other.Segments;
+	}
+
+	bool operator!=(const FPropertyCommentPath& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FPropertyCommentPath& Path)
+	{
+		uint32 Hash = 0;
+		for (const FPropertyCommentPathSegment& Segment : Path.Segments)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Segment));
+		}
+		return Hash;
+	}
+};
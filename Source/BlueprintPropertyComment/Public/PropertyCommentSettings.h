@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "PropertyCommentSettings.generated.h"
+
+UENUM()
+enum class EPropertyCommentStorage : uint8
+{
+	/** Comments are saved inside the blueprint package. Editing a comment dirties the blueprint. */
+	Blueprint,
+
+	/** Comments are saved to one small text file per blueprint, named after the blueprint guid. The blueprint package is never touched. */
+	Sidecar UMETA(DisplayName = "Sidecar Files"),
+};
+
+/**
+ * Project settings of the property comments, found under Project Settings > Plugins > Property Comments.
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Property Comments"))
+class BLUEPRINTPROPERTYCOMMENT_API UPropertyCommentSettings final : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPropertyCommentSettings();
+
+	/**
+	 * Where comments are stored. Blueprints that already hold comments in their package keep
+	 * storing them there.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = Storage)
+	EPropertyCommentStorage Storage = EPropertyCommentStorage::Blueprint;
+
+	/** Directory holding the sidecar files, relative to the project directory. */
+	UPROPERTY(config, EditAnywhere, Category = Storage, meta = (EditCondition = "Storage == EPropertyCommentStorage::Sidecar", RelativeToGameDir))
+	FDirectoryPath SidecarDirectory;
+
+	/**
+	 * Stores comments as culture-invariant strings. Identical comments share one string in memory
+	 * and one entry in the string table saved with the blueprint, which is compressed when large.
+	 * Comments stored this way are not gathered for localization.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = Storage)
+	bool bCompactCommentTexts = false;
+
+	FString GetSidecarDirectory() const;
+
+	//~ Begin UDeveloperSettings Interface
+	virtual FName GetCategoryName() const override;
+	//~ End UDeveloperSettings Interface
+
+#if WITH_EDITOR
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+#endif
+};
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PropertyCommentPath.h"
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Immutable copy of the comments of one blueprint, for readers off the game thread such as
+ * validators, cook reports or search tasks. A snapshot never changes after it is built, so it can
+ * be read from any thread without locking while the editor keeps editing the comments.
+ *
+ * Comments are stored as display strings rather than FText, so that readers never reach into the
+ * localization system from another thread.
+ */
+class BLUEPRINTPROPERTYCOMMENT_API FPropertyCommentSnapshot
+{
+public:
+	FPropertyCommentSnapshot(const FSoftObjectPath& InBlueprint, uint32 InRevision, TMap<FPropertyCommentPath, FString>&& InComments);
+
+	const FSoftObjectPath& GetBlueprint() const;
+
+	/** Revision of the extension the snapshot was taken from. */
+	uint32 GetRevision() const;
+
+	int32 GetNumComments() const;
+	const FString* FindComment(const FPropertyCommentPath& PropertyPath) const;
+	void ForEachComment(TFunctionRef<void(const FPropertyCommentPath&, const FString&)> Callback) const;
+
+private:
+	FSoftObjectPath Blueprint;
+	uint32 Revision;
+	TMap<FPropertyCommentPath, FString> Comments;
+};
+
+using FPropertyCommentSnapshotRef = TSharedRef<const FPropertyCommentSnapshot, ESPMode::ThreadSafe>;
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+/** Shown with "stat PropertyComment". The same scopes appear in Unreal Insights as CPU trace events. */
+DECLARE_STATS_GROUP(TEXT("Property Comments"), STATGROUP_PropertyComment, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Resolve Blueprint"), STAT_PropertyComment_ResolveBlueprint, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Path"), STAT_PropertyComment_BuildPath, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Extension"), STAT_PropertyComment_FindExtension, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fetch Comment"), STAT_PropertyComment_FetchComment, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Row Display"), STAT_PropertyComment_UpdateRowDisplay, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Lookups"), STAT_PropertyComment_PathLookups, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Resolve Cache Hits"), STAT_PropertyComment_ResolveCacheHits, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Resolve Cache Misses"), STAT_PropertyComment_ResolveCacheMisses, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Row Display Cache Hits"), STAT_PropertyComment_DisplayCacheHits, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Row Display Cache Misses"), STAT_PropertyComment_DisplayCacheMisses, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Preview Layouts"), STAT_PropertyComment_PreviewLayouts, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
+
+/** Names added to the global name table while parsing path strings. Building keys from handles never adds any. */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Name Table Entries Created"), STAT_PropertyComment_NamesCreated, STATGROUP_PropertyComment, BLUEPRINTPROPERTYCOMMENT_API);
@@ -0,0 +1,15 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Escapes comments into a single tab-free line for the line based comment files, the sidecar files
+ * and the import/export format. Backslashes, tabs and line breaks are written as backslash sequences.
+ */
+namespace PropertyCommentTextEscape
+{
+	BLUEPRINTPROPERTYCOMMENT_API FString Escape(const FString& Text);
+	BLUEPRINTPROPERTYCOMMENT_API FString Unescape(FStringView Text);
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Splits comment text into lowercase alphanumeric tokens. Shared by every comment index so
+ * that queries and indexed text are always folded the same way. Safe to call from any thread.
+ */
+namespace PropertyCommentTokenizer
+{
+	template <typename AllocatorType>
+	void Tokenize(FStringView Text, TArray<FString, AllocatorType>& OutTokens)
+	{
+		int32 TokenStart = INDEX_NONE;
+		for (int32 Index = 0; Index <= Text.Len(); ++Index)
+		{
+			const bool bIsTokenChar = Index < Text.Len() && FChar::IsAlnum(Text[Index]);
+			if (bIsTokenChar && TokenStart == INDEX_NONE)
+			{
+				TokenStart = Index;
+			}
+			else if (!bIsTokenChar && TokenStart != INDEX_NONE)
+			{
+				FString& Token = OutTokens.Emplace_GetRef(Text.Mid(TokenStart, Index - TokenStart));
+				Token.ToLowerInline();
+				TokenStart = INDEX_NONE;
+			}
+		}
+	}
+}
@@ -41,6 +41,13 @@ public class BlueprintPropertyCommentEditor : ModuleRules
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...
 				"EditorStyle",
+				"AssetRegistry",
+				"PropertyEditor",
+				"UnrealEd",
+				"WorkspaceMenuStructure",
+				"BlueprintGraph",
+				"Json",
+				"Kismet",
 			}
 			);
 		
@@ -1,101 +1,155 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BlueprintPropertyCommentEditor.h"
+#include "BlueprintPropertyComment.h"
 #include "PropertyCommentExtension.h"
+#include "PropertyCommentStats.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintEditorModule.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
 #include "Misc/MessageDialog.h"
+#include "Misc/PackageName.h"
+#include "PropertyCommentRenameHandler.h"
+#include "PropertyCommentRow.h"
+#include "ScopedTransaction.h"
 #include "UI/CommentEditOverlay.h"
+#include "UI/PropertyCommentOverviewTabFactory.h"
+#include "UI/SPropertyCommentSearch.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 #define LOCTEXT_NAMESPACE "FBlueprintPropertyCommentEditorModule"
 
 namespace
 {
-	FString GetPropertyPathRecursive(const TSharedPtr<IPropertyHandle>& InHandle)
+	const FName PropertyCommentSearchTabName{"PropertyCommentSearch"};
+
+	void DumpCommentStats()
 	{
-		if (!InHandle.IsValid() || !InHandle->IsValidHandle())
+		TArray<const UPropertyCommentExtension*> Extensions;
+		for (TObjectIterator<UPropertyCommentExtension> It; It; ++It)
 		{
-			return FString{};
+			if (IsValid(*It) && !It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				Extensions.Add(*It);
+			}
 		}
 
-		TSharedPtr<IPropertyHandle> Handle = InHandle;
-		TArray<FString, TInlineAllocator<16>> Paths;
+		Extensions.Sort([](const UPropertyCommentExtension& A, const UPropertyCommentExtension& B)
+		{
+			return A.GetAllocatedSize() > B.GetAllocatedSize();
+		});
 
-		while (Handle && Handle->IsValidHandle())
+		int32 TotalComments = 0;
+		SIZE_T TotalSize = 0;
+		for (const UPropertyCommentExtension* Extension : Extensions)
 		{
-			if (FString SubPath = Handle->GeneratePathToProperty(); !SubPath.IsEmpty())
-			{
-				Paths.Add(MoveTemp(SubPath));
-			}
-			Handle = Handle->GetParentHandle();
+			const SIZE_T Size = Extension->GetAllocatedSize();
+			TotalComments += Extension->GetNumComments();
+			TotalSize += Size;
+			UE_LOG(LogBlueprintPropertyComment, Display, TEXT("%6d comments %10llu bytes  %s"),
+				Extension->GetNumComments(), static_cast<uint64>(Size), *GetPathNameSafe(Extension->GetBlueprint()));
 		}
 
-		Algo::Reverse(Paths);
-		const FString Path = FString::Join(Paths, TEXT("->"));
-		return Path;
+		UE_LOG(LogBlueprintPropertyComment, Display, TEXT("%d comments in %d loaded blueprints, %llu bytes"),
+			TotalComments, Extensions.Num(), static_cast<uint64>(TotalSize));
 	}
 
-	UBlueprint* GetBlueprintFromPropertyHandle(const TSharedPtr<IPropertyHandle>& PropertyHandle)
+	FAutoConsoleCommand DumpCommentStatsCommand(
+		TEXT("PropertyComments.DumpStats"),
+		TEXT("Logs the comment count and memory of every loaded blueprint with property comments, largest first."),
+		FConsoleCommandDelegate::CreateStatic(&DumpCommentStats));
+}
+
+void FBlueprintPropertyCommentEditorModule::StartupModule()
+{
+	// Commandlets and cooks never show a details panel, none of the hooks would ever run there
+	if (IsRunningCommandlet())
 	{
-		UBlueprint* Blueprint = nullptr;
+		return;
+	}
 
-		if (PropertyHandle && PropertyHandle->GetNumOuterObjects() == 1)
-		{
-			TArray<UObject*> OuterObjects;
-			PropertyHandle->GetOuterObjects(OuterObjects);
-			const UObject* Outer = OuterObjects[0];
-			if (Outer->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
-			{
-				for (; IsValid(Outer); Outer = Outer->GetOuter())
-				{
-					const UClass* OuterClass = Outer->GetClass();
-					if (const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Outer))
-					{
-						Blueprint = UBlueprint::GetBlueprintFromClass(BlueprintClass);
-						break;
-					}
-
-					Blueprint = UBlueprint::GetBlueprintFromClass(OuterClass);
-					if (IsValid(Blueprint))
-					{
-						break;
-					}
-				}
-			}
-		}
+	RegisterSearchTab();
 
-		return Blueprint;
+	// Loading the property editor or the blueprint editor from here would pull them into the startup
+	// of the editor. Their extensions are added whenever something that needs them loads them.
+	// Variables are only renamed in the blueprint editor, so the rename handler waits for it as well.
+	const bool bPropertyEditorLoaded = FModuleManager::Get().IsModuleLoaded("PropertyEditor");
+	const bool bKismetLoaded = FModuleManager::Get().IsModuleLoaded("Kismet");
+	if (bPropertyEditorLoaded)
+	{
+		RegisterDetailRowExtension();
+	}
+	if (bKismetLoaded)
+	{
+		RegisterBlueprintEditorTabs();
+		RegisterRenameHandler();
 	}
+	if (!bPropertyEditorLoaded || !bKismetLoaded)
+	{
+		FModuleManager::Get().OnModulesChanged().AddRaw(this, &FBlueprintPropertyCommentEditorModule::HandleModulesChanged);
+	}
+}
+
+void FBlueprintPropertyCommentEditorModule::ShutdownModule()
+{
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+	DeregisterDetailRowExtension();
+	DeregisterBlueprintEditorTabs();
+	DeregisterAssetRegistryActions();
+	DeregisterBlueprintCompileActions();
+	bSessionHooksRegistered = false;
+	DeregisterRenameHandler();
+	DeregisterSearchTab();
+	CloseCurrentOverlayWidget();
+	OverlayWidgetPool.Empty();
+	BlueprintResolveCache.Reset();
+	InheritedCommentCache.Reset();
+}
 
-	bool BlueprintHasComment(const UBlueprint* Blueprint, const TSharedPtr<IPropertyHandle>& PropertyHandle)
+void FBlueprintPropertyCommentEditorModule::HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason != EModuleChangeReason::ModuleLoaded)
 	{
-		check(IsValid(Blueprint))
+		return;
+	}
 
-		const UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
-		if (!IsValid(Extension))
-		{
-			return false;
-		}
+	if (ModuleName == "PropertyEditor")
+	{
+		RegisterDetailRowExtension();
+	}
+	else if (ModuleName == "Kismet")
+	{
+		RegisterBlueprintEditorTabs();
+		RegisterRenameHandler();
+	}
 
-		const FName PropertyKey = FName{GetPropertyPathRecursive(PropertyHandle)};
-		return Extension->HasComment(PropertyKey);
+	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor") && FModuleManager::Get().IsModuleLoaded("Kismet"))
+	{
+		FModuleManager::Get().OnModulesChanged().RemoveAll(this);
 	}
 }
 
-void FBlueprintPropertyCommentEditorModule::StartupModule()
+void FBlueprintPropertyCommentEditorModule::RegisterSessionHooks()
 {
-	RegisterDetailRowExtension();
-	RegisterAssetRegistryActions();
-}
+	if (bSessionHooksRegistered)
+	{
+		return;
+	}
 
-void FBlueprintPropertyCommentEditorModule::ShutdownModule()
-{
-	DeregisterDetailRowExtension();
-	DeregisterAssetRegistryActions();
+	bSessionHooksRegistered = true;
+	RegisterAssetRegistryActions();
+	RegisterBlueprintCompileActions();
 }
 
 void FBlueprintPropertyCommentEditorModule::RegisterDetailRowExtension()
 {
-	FPropertyEditorModule& Module = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	FPropertyEditorModule& Module = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
 	FOnGenerateGlobalRowExtension& RowExtensionDelegate = Module.GetGlobalRowExtensionDelegate();
 	RowExtensionDelegate.AddRaw(this, &FBlueprintPropertyCommentEditorModule::HandleCreatePropertyRowExtension);
 }
@@ -112,20 +166,24 @@ void FBlueprintPropertyCommentEditorModule::DeregisterDetailRowExtension()
 void FBlueprintPropertyCommentEditorModule::HandleCreatePropertyRowExtension(const FOnGenerateGlobalRowExtensionArgs& InArgs,
 	TArray<FPropertyRowExtensionButton>& OutExtensions)
 {
+	RegisterSessionHooks();
+
+	const TSharedRef<FPropertyCommentRow> Row = MakeShared<FPropertyCommentRow>(InArgs.PropertyHandle, BlueprintResolveCache);
+
 	auto& [Icon, Label, ToolTip, UIAction] = OutExtensions.AddDefaulted_GetRef();
-	Icon = TAttribute<FSlateIcon>::Create([Handle = InArgs.PropertyHandle, this]()
+	Icon = TAttribute<FSlateIcon>::Create([Row, this]()
 	{
-		return GetCommentIcon(Handle);
+		return GetCommentIcon(Row);
 	});
 
-	Label = TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::GetCommentLabel, InArgs.PropertyHandle));
-	ToolTip = TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::GetCommentTooltip, InArgs.PropertyHandle));
+	Label = TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::GetCommentLabel, Row));
+	ToolTip = TAttribute<FText>::Create(TAttribute<FText>::FGetter::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::GetCommentTooltip, Row));
 
 	UIAction = FUIAction(
-		FExecuteAction::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::OnClickComment, InArgs.PropertyHandle),
-		FCanExecuteAction::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::CanClickComment, InArgs.PropertyHandle),
+		FExecuteAction::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::OnClickComment, Row),
+		FCanExecuteAction::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::CanClickComment, Row),
 		FGetActionCheckState::CreateLambda([](){ return ECheckBoxState::Undetermined; }),
-		FIsActionButtonVisible::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::CanClickComment, InArgs.PropertyHandle)
+		FIsActionButtonVisible::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::CanClickComment, Row)
 	);
 }
 
@@ -133,6 +191,7 @@ void FBlueprintPropertyCommentEditorModule::RegisterAssetRegistryActions()
 {
 	const FAssetRegistryModule& Module = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	Module.Get().OnAssetRemoved().AddRaw(this, &FBlueprintPropertyCommentEditorModule::HandleOnAssetRemoved);
+	Module.Get().OnAssetRenamed().AddRaw(this, &FBlueprintPropertyCommentEditorModule::HandleOnAssetRenamed);
 }
 
 void FBlueprintPropertyCommentEditorModule::DeregisterAssetRegistryActions()
@@ -141,55 +200,303 @@ void FBlueprintPropertyCommentEditorModule::DeregisterAssetRegistryActions()
 	{
 		const FAssetRegistryModule& Module = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 		Module.Get().OnAssetRemoved().RemoveAll(this);
+		Module.Get().OnAssetRenamed().RemoveAll(this);
 	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(AssetRegistryFlushHandle);
+	AssetRegistryFlushHandle.Reset();
+	bPendingOverlayClose = false;
+	bPendingBlueprintInvalidation = false;
 }
 
 void FBlueprintPropertyCommentEditorModule::HandleOnAssetRemoved(const FAssetData& AssetData)
 {
-	CloseCurrentOverlayWidget();
+	// Large deletes and registry scans send thousands of these, most of them about other asset types
+	const bool bIsOverlayPackage = OverlayPackageNames.Contains(AssetData.PackageName);
+	const bool bIsBlueprint = AssetData.TagsAndValues.Contains(FBlueprintTags::ParentClassPath);
+	if (!bIsOverlayPackage && !bIsBlueprint)
+	{
+		return;
+	}
+
+	bPendingOverlayClose |= bIsOverlayPackage;
+	bPendingBlueprintInvalidation |= bIsBlueprint;
+	ScheduleAssetRegistryFlush();
 }
 
-FSlateIcon FBlueprintPropertyCommentEditorModule::GetCommentIcon(TSharedPtr<IPropertyHandle> PropertyHandle)
+void FBlueprintPropertyCommentEditorModule::HandleOnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
 {
-	FName BrushName{"NoBrush"};
+	if (!AssetData.TagsAndValues.Contains(FBlueprintTags::ParentClassPath))
+	{
+		return;
+	}
 
-	const UBlueprint* Blueprint = GetBlueprintFromPropertyHandle(PropertyHandle);
-	if (IsValid(Blueprint))
+	// The overlay keeps editing the same blueprint object, it only needs to know its new package
+	if (OverlayPackageNames.Remove(FName{FPackageName::ObjectPathToPackageName(OldObjectPath)}) > 0)
 	{
-		const bool bHasComment = BlueprintHasComment(Blueprint, PropertyHandle);
-		BrushName = bHasComment ? "Icons.Comment" : "Icons.Toolbar.Details";
+		OverlayPackageNames.Add(AssetData.PackageName);
 	}
-	return FSlateIcon(FAppStyle::Get().GetStyleSetName(), BrushName);
+
+	// Sidecar files record the path of their blueprint, so that it can be found without loading it
+	if (const UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+	{
+		UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
+		if (IsValid(Extension) && Extension->IsStoredInSidecar() && Extension->GetNumComments() > 0)
+		{
+			Extension->MarkCommentsDirty();
+		}
+	}
+
+	bPendingBlueprintInvalidation = true;
+	ScheduleAssetRegistryFlush();
+}
+
+void FBlueprintPropertyCommentEditorModule::ScheduleAssetRegistryFlush()
+{
+	if (!AssetRegistryFlushHandle.IsValid())
+	{
+		AssetRegistryFlushHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::FlushAssetRegistryChanges));
+	}
+}
+
+bool FBlueprintPropertyCommentEditorModule::FlushAssetRegistryChanges(float DeltaTime)
+{
+	AssetRegistryFlushHandle.Reset();
+
+	if (bPendingOverlayClose)
+	{
+		CloseCurrentOverlayWidget();
+	}
+
+	if (bPendingBlueprintInvalidation)
+	{
+		InvalidateResolvedBlueprints();
+	}
+
+	bPendingOverlayClose = false;
+	bPendingBlueprintInvalidation = false;
+
+	// Runs once per batch, the next event schedules it again
+	return false;
+}
+
+void FBlueprintPropertyCommentEditorModule::RegisterBlueprintCompileActions()
+{
+	// GEditor does not exist yet when the module is loaded during engine pre-init
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FBlueprintPropertyCommentEditorModule::InvalidateResolvedBlueprints);
+		GEditor->OnBlueprintReinstanced().AddRaw(this, &FBlueprintPropertyCommentEditorModule::InvalidateResolvedBlueprints);
+	}
+	else
+	{
+		FCoreDelegates::OnPostEngineInit.AddRaw(this, &FBlueprintPropertyCommentEditorModule::RegisterBlueprintCompileActions);
+	}
+}
+
+void FBlueprintPropertyCommentEditorModule::DeregisterBlueprintCompileActions()
+{
+	FCoreDelegates::OnPostEngineInit.RemoveAll(this);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+		GEditor->OnBlueprintReinstanced().RemoveAll(this);
+	}
+}
+
+void FBlueprintPropertyCommentEditorModule::InvalidateResolvedBlueprints()
+{
+	BlueprintResolveCache.Reset();
+	InheritedCommentCache.InvalidateReparented();
+	FPropertyCommentRow::InvalidateAll();
+}
+
+void FBlueprintPropertyCommentEditorModule::RegisterRenameHandler()
+{
+	RenameHandler = MakeUnique<FPropertyCommentRenameHandler>();
 }
 
-FText FBlueprintPropertyCommentEditorModule::GetCommentLabel(TSharedPtr<IPropertyHandle> PropertyHandle)
+void FBlueprintPropertyCommentEditorModule::DeregisterRenameHandler()
+{
+	RenameHandler.Reset();
+}
+
+void FBlueprintPropertyCommentEditorModule::RegisterSearchTab()
+{
+	// The tab is global, only the instance that registered it may remove it again
+	if (FGlobalTabmanager::Get()->HasTabSpawner(PropertyCommentSearchTabName))
+	{
+		return;
+	}
+
+	bSearchTabRegistered = true;
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(PropertyCommentSearchTabName, FOnSpawnTab::CreateRaw(this, &FBlueprintPropertyCommentEditorModule::SpawnSearchTab))
+		.SetDisplayName(LOCTEXT("SearchTabTitle", "Property Comments"))
+		.SetTooltipText(LOCTEXT("SearchTabTooltip", "Search the property comments of every blueprint in the project"))
+		.SetIcon(FSlateIcon(FAppStyle::Get().GetStyleSetName(), "Icons.Comment"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void FBlueprintPropertyCommentEditorModule::DeregisterSearchTab()
+{
+	if (bSearchTabRegistered && FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(PropertyCommentSearchTabName);
+	}
+	bSearchTabRegistered = false;
+}
+
+TSharedRef<SDockTab> FBlueprintPropertyCommentEditorModule::SpawnSearchTab(const FSpawnTabArgs& Args)
+{
+	return SNew(SDockTab)
+	.TabRole(ETabRole::NomadTab)
+	[
+		SNew(SPropertyCommentSearch)
+	];
+}
+
+void FBlueprintPropertyCommentEditorModule::RegisterBlueprintEditorTabs()
+{
+	FBlueprintEditorModule& Module = FModuleManager::GetModuleChecked<FBlueprintEditorModule>("Kismet");
+	Module.OnRegisterTabsForEditor().AddRaw(this, &FBlueprintPropertyCommentEditorModule::HandleRegisterBlueprintEditorTabs);
+}
+
+void FBlueprintPropertyCommentEditorModule::DeregisterBlueprintEditorTabs()
+{
+	if (FBlueprintEditorModule* Module = FModuleManager::GetModulePtr<FBlueprintEditorModule>("Kismet"))
+	{
+		Module->OnRegisterTabsForEditor().RemoveAll(this);
+	}
+}
+
+void FBlueprintPropertyCommentEditorModule::HandleRegisterBlueprintEditorTabs(FWorkflowAllowedTabSet& TabFactories, FName ModeName,
+	TSharedPtr<FBlueprintEditor> BlueprintEditor)
+{
+	TabFactories.RegisterFactory(MakeShared<FPropertyCommentOverviewTabFactory>(BlueprintEditor));
+}
+
+FSlateIcon FBlueprintPropertyCommentEditorModule::GetCommentIcon(TSharedRef<FPropertyCommentRow> Row)
+{
+	// Comments only change on user actions, so most frames end here
+	if (!Row->IsIconStale())
+	{
+		INC_DWORD_STAT(STAT_PropertyComment_DisplayCacheHits);
+		return Row->GetCachedIcon();
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::UpdateRowIcon);
+	SCOPE_CYCLE_COUNTER(STAT_PropertyComment_UpdateRowDisplay);
+	INC_DWORD_STAT(STAT_PropertyComment_DisplayCacheMisses);
+	Row->SetIcon(ComputeCommentIcon(*Row));
+	return Row->GetCachedIcon();
+}
+
+FText FBlueprintPropertyCommentEditorModule::GetCommentLabel(TSharedRef<FPropertyCommentRow> Row)
 {
 	return LOCTEXT("AddComment", "Add Comment");
 }
 
-FText FBlueprintPropertyCommentEditorModule::GetCommentTooltip(TSharedPtr<IPropertyHandle> PropertyHandle)
+FText FBlueprintPropertyCommentEditorModule::GetCommentTooltip(TSharedRef<FPropertyCommentRow> Row)
+{
+	// Only asked for when the row is hovered, which is the first time the comment texts are needed
+	if (!Row->IsTooltipStale())
+	{
+		INC_DWORD_STAT(STAT_PropertyComment_DisplayCacheHits);
+		return Row->GetCachedTooltip();
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::UpdateRowTooltip);
+	SCOPE_CYCLE_COUNTER(STAT_PropertyComment_UpdateRowDisplay);
+	INC_DWORD_STAT(STAT_PropertyComment_DisplayCacheMisses);
+	Row->SetTooltip(ComputeCommentTooltip(*Row));
+	return Row->GetCachedTooltip();
+}
+
+FSlateIcon FBlueprintPropertyCommentEditorModule::ComputeCommentIcon(FPropertyCommentRow& Row)
+{
+	FName BrushName{"NoBrush"};
+
+	const FPropertyCommentPath& PropertyPath = Row.GetPropertyPath();
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : Row.GetBlueprints())
+	{
+		if (!Blueprint.IsValid())
+		{
+			continue;
+		}
+
+		BrushName = "Icons.Toolbar.Details";
+
+		// Includes the comments left on parent blueprints, so inherited properties show them too
+		const TSharedRef<const FInheritedCommentView> Comments = InheritedCommentCache.GetView(Blueprint.Get());
+
+		// Flag parents of commented properties so that collapsed rows still show there is something inside
+		if (Comments->HasComment(PropertyPath))
+		{
+			BrushName = "Icons.Comment";
+			break;
+		}
+		else if (Comments->GetNumCommentsBelow(PropertyPath) > 0)
+		{
+			BrushName = "Icons.Info";
+		}
+	}
+	return FSlateIcon(FAppStyle::Get().GetStyleSetName(), BrushName);
+}
+
+FText FBlueprintPropertyCommentEditorModule::ComputeCommentTooltip(FPropertyCommentRow& Row)
 {
 	static const FText AddComment = LOCTEXT("AddCommentTooltip", "Click to add comment");
 
-	const UBlueprint* Blueprint = GetBlueprintFromPropertyHandle(PropertyHandle);
+	const UBlueprint* Blueprint = Row.GetBlueprint();
 	if (!IsValid(Blueprint))
 	{
 		return FText{};
 	}
 
-	const UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
-	if (!IsValid(Extension))
+	const FPropertyCommentPath& PropertyPath = Row.GetPropertyPath();
+	const TArray<TWeakObjectPtr<UBlueprint>>& Blueprints = Row.GetBlueprints();
+	if (Blueprints.Num() > 1)
+	{
+		// A multi-selection only shows the comment when every selected blueprint has the same one
+		const FText* FirstComment = InheritedCommentCache.GetView(Blueprint)->FindComment(PropertyPath);
+		for (int32 Index = 1; Index < Blueprints.Num(); ++Index)
+		{
+			const FText* Comment = Blueprints[Index].IsValid() ? InheritedCommentCache.GetView(Blueprints[Index].Get())->FindComment(PropertyPath) : nullptr;
+			const bool bSameComment = Comment && FirstComment ? Comment->ToString().Equals(FirstComment->ToString(), ESearchCase::CaseSensitive) : Comment == FirstComment;
+			if (!bSameComment)
+			{
+				return FText::Format(LOCTEXT("MultipleCommentsTooltip", "The selected blueprints have different comments. Click to set one comment on all {0} of them"), Blueprints.Num());
+			}
+		}
+	}
+
+	const TSharedRef<const FInheritedCommentView> Comments = InheritedCommentCache.GetView(Blueprint);
+	if (Comments->IsEmpty())
 	{
 		return AddComment;
 	}
 
-	FText Comment;
-	const FName PropertyKey = FName{GetPropertyPathRecursive(PropertyHandle)};
-	const bool bHasComment = Extension->GetComment(PropertyKey, Comment);
-	return bHasComment ? Comment : AddComment;
+	if (const UPropertyCommentExtension* Owner = Comments->FindOwner(PropertyPath))
+	{
+		const FText* Comment = Owner->FindComment(PropertyPath);
+		const UBlueprint* OwnerBlueprint = Owner->GetBlueprint();
+		if (Comment && OwnerBlueprint != Blueprint)
+		{
+			return FText::Format(LOCTEXT("InheritedCommentTooltip", "{0}\n\nInherited from {1}. Click to override the comment in this blueprint"),
+				*Comment, FText::FromName(OwnerBlueprint->GetFName()));
+		}
+		return Comment ? *Comment : FText::GetEmpty();
+	}
+
+	if (const int32 NumCommentsBelow = Comments->GetNumCommentsBelow(PropertyPath); NumCommentsBelow > 0)
+	{
+		return FText::Format(LOCTEXT("NestedCommentsTooltip", "{0} nested {0}|plural(one=property has,other=properties have) comments. Click to add comment"), NumCommentsBelow);
+	}
+
+	return AddComment;
 }
 
-void FBlueprintPropertyCommentEditorModule::OnClickComment(TSharedPtr<IPropertyHandle> PropertyHandle)
+void FBlueprintPropertyCommentEditorModule::OnClickComment(TSharedRef<FPropertyCommentRow> Row)
 {
 	TSharedPtr<SWindow> ActiveWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
 	if (!ActiveWindow)
@@ -212,41 +519,45 @@ void FBlueprintPropertyCommentEditorModule::OnClickComment(TSharedPtr<IPropertyH
 	// Close any already opened widgets
 	CloseCurrentOverlayWidget();
 
-	UBlueprint* Blueprint = GetBlueprintFromPropertyHandle(PropertyHandle);
-	check(IsValid(Blueprint));
+	// Every selected blueprint gets the comment, so editing many defaults at once is one action
+	const FPropertyCommentPath PropertyPath = Row->GetPropertyPath();
+	TArray<FPropertyCommentTarget> Targets;
+	for (const TWeakObjectPtr<UBlueprint>& Blueprint : Row->GetBlueprints())
+	{
+		if (Blueprint.IsValid())
+		{
+			Targets.Add({Blueprint.Get(), PropertyPath});
+			OverlayPackageNames.Add(Blueprint->GetOutermost()->GetFName());
+		}
+	}
+	check(Targets.Num() > 0);
 
+	// Start from the visible comment only if the selected blueprints agree on it. An inherited comment
+	// counts too, so overriding it starts from the parent's text instead of an empty box.
 	FText InitialComment;
-	const FName PropertyKey = FName{GetPropertyPathRecursive(PropertyHandle)};
-	const UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
-	if (IsValid(Extension))
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
 	{
-		Extension->GetComment(PropertyKey, InitialComment);
+		const FText* VisibleComment = InheritedCommentCache.GetView(Targets[Index].Blueprint)->FindComment(PropertyPath);
+		FText Comment = VisibleComment ? *VisibleComment : FText::GetEmpty();
+
+		if (Index > 0 && !Comment.ToString().Equals(InitialComment.ToString(), ESearchCase::CaseSensitive))
+		{
+			InitialComment = FText::GetEmpty();
+			break;
+		}
+		InitialComment = MoveTemp(Comment);
 	}
 
-	ActiveWindow->AddOverlaySlot()
-	[
-		SAssignNew(CurrentOverlayWidget, SCommentEditOverlay)
-		.ParentWindow(ActiveWindow)
-		.Content(InitialComment)
-		.OnConfirmClicked_Lambda([Blueprint, PropertyKey, this](FText Comment)
+	CurrentOverlayWidget = GetPooledOverlayWidget(ActiveWindow.ToSharedRef());
+	CurrentOverlayWidget->Retarget(InitialComment,
+		FOnConfirmAddComment::CreateLambda([Targets, this](FText Comment)
 		{
 			CloseCurrentOverlayWidget();
-			UPropertyCommentExtension::TryAddPropertyComment(Blueprint, PropertyKey, MoveTemp(Comment));
-		})
-		.OnRemoveClicked_Lambda([Blueprint, PropertyKey, this]()
-		{
-			const EAppReturnType::Type MessageType = FMessageDialog::Open(
-					EAppMsgType::OkCancel,
-					LOCTEXT("RemoveComment_Message", "Are you sure you want to remove this comment?"));
 
-			if (MessageType == EAppReturnType::Cancel)
-			{
-				return;
-			}
-			CloseCurrentOverlayWidget();
-			UPropertyCommentExtension::TryRemovePropertyComment(Blueprint, PropertyKey);
-		})
-		.OnCancelClicked_Lambda([this](bool bCommentChanged)
+			const FScopedTransaction Transaction(FText::Format(LOCTEXT("SetPropertyComment", "Set Property Comment ({0})"), Targets.Num()));
+			UPropertyCommentExtension::TryAddPropertyComments(Targets, Comment);
+		}),
+		FOnCancelAddComment::CreateLambda([this](bool bCommentChanged)
 		{
 			if (bCommentChanged)
 			{
@@ -260,13 +571,32 @@ void FBlueprintPropertyCommentEditorModule::OnClickComment(TSharedPtr<IPropertyH
 				}
 			}
 			CloseCurrentOverlayWidget();
-		})
+		}),
+		FSimpleDelegate::CreateLambda([Targets, this]()
+		{
+			const EAppReturnType::Type MessageType = FMessageDialog::Open(
+					EAppMsgType::OkCancel,
+					LOCTEXT("RemoveComment_Message", "Are you sure you want to remove this comment?"));
+
+			if (MessageType == EAppReturnType::Cancel)
+			{
+				return;
+			}
+			CloseCurrentOverlayWidget();
+
+			const FScopedTransaction Transaction(FText::Format(LOCTEXT("RemovePropertyComment", "Remove Property Comment ({0})"), Targets.Num()));
+			UPropertyCommentExtension::TryRemovePropertyComments(Targets);
+		}));
+
+	ActiveWindow->AddOverlaySlot()
+	[
+		CurrentOverlayWidget.ToSharedRef()
 	];
 }
 
-bool FBlueprintPropertyCommentEditorModule::CanClickComment(TSharedPtr<IPropertyHandle> PropertyHandle)
+bool FBlueprintPropertyCommentEditorModule::CanClickComment(TSharedRef<FPropertyCommentRow> Row)
 {
-	const UBlueprint* Blueprint = GetBlueprintFromPropertyHandle(PropertyHandle);
+	const UBlueprint* Blueprint = Row->GetBlueprint();
 	return IsValid(Blueprint);
 }
 
@@ -282,6 +612,26 @@ void FBlueprintPropertyCommentEditorModule::CloseCurrentOverlayWidget()
 	}
 
 	CurrentOverlayWidget = nullptr;
+	OverlayPackageNames.Reset();
+}
+
+TSharedRef<SCommentEditOverlay> FBlueprintPropertyCommentEditorModule::GetPooledOverlayWidget(const TSharedRef<SWindow>& Window)
+{
+	// Overlays of closed windows are dropped here rather than tracking window destruction
+	OverlayWidgetPool.RemoveAll([](const TSharedRef<SCommentEditOverlay>& Overlay)
+	{
+		return !Overlay->GetParentWindow().IsValid();
+	});
+
+	for (const TSharedRef<SCommentEditOverlay>& Overlay : OverlayWidgetPool)
+	{
+		if (Overlay->GetParentWindow().HasSameObject(&Window.Get()))
+		{
+			return Overlay;
+		}
+	}
+
+	return OverlayWidgetPool.Add_GetRef(SNew(SCommentEditOverlay).ParentWindow(Window));
 }
 
 #undef LOCTEXT_NAMESPACE
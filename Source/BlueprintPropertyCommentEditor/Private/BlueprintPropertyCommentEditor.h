@@ -3,8 +3,15 @@
 #pragma once
 
 #include "IBlueprintPropertyCommentEditor.h"
+#include "Containers/Ticker.h"
+#include "BlueprintResolveCache.h"
+#include "InheritedCommentCache.h"
 
+class FBlueprintEditor;
+class FPropertyCommentRenameHandler;
+class FPropertyCommentRow;
 class SCommentEditOverlay;
+class FWorkflowAllowedTabSet;
 
 class FBlueprintPropertyCommentEditorModule final : public IBlueprintPropertyCommentEditorModule
 {
@@ -13,6 +20,19 @@ public:
 	virtual void ShutdownModule() override;
 
 private:
+	// Drive the row attribute callbacks directly, to time them and to check what they return
+	friend class UPropertyCommentBenchmarkCommandlet;
+	friend class FPropertyCommentRowDisplayTest;
+	friend class FPropertyCommentRowInvalidationTest;
+
+	// Starts a separate instance and checks which hooks StartupModule and the first row register
+	friend class FPropertyCommentDeferredHooksTest;
+
+	void HandleModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+
+	/** Hooks that only matter once a details panel shows comment rows, registered with the first row. */
+	void RegisterSessionHooks();
+
 	void RegisterDetailRowExtension();
 	void DeregisterDetailRowExtension();
 	void HandleCreatePropertyRowExtension(const FOnGenerateGlobalRowExtensionArgs& InArgs, TArray<FPropertyRowExtensionButton>& OutExtensions);
@@ -20,15 +40,53 @@ private:
 	void RegisterAssetRegistryActions();
 	void DeregisterAssetRegistryActions();
 	void HandleOnAssetRemoved(const FAssetData& AssetData);
+	void HandleOnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void ScheduleAssetRegistryFlush();
+	bool FlushAssetRegistryChanges(float DeltaTime);
+
+	void RegisterBlueprintCompileActions();
+	void DeregisterBlueprintCompileActions();
+	void InvalidateResolvedBlueprints();
+
+	void RegisterRenameHandler();
+	void DeregisterRenameHandler();
 
-	FSlateIcon GetCommentIcon(TSharedPtr<IPropertyHandle> PropertyHandle);
-	FText GetCommentLabel(TSharedPtr<IPropertyHandle> PropertyHandle);
-	FText GetCommentTooltip(TSharedPtr<IPropertyHandle> PropertyHandle);
+	void RegisterSearchTab();
+	void DeregisterSearchTab();
+	TSharedRef<SDockTab> SpawnSearchTab(const FSpawnTabArgs& Args);
 
-	void OnClickComment(TSharedPtr<IPropertyHandle> PropertyHandle);
-	bool CanClickComment(TSharedPtr<IPropertyHandle> PropertyHandle);
+	void RegisterBlueprintEditorTabs();
+	void DeregisterBlueprintEditorTabs();
+	void HandleRegisterBlueprintEditorTabs(FWorkflowAllowedTabSet& TabFactories, FName ModeName, TSharedPtr<FBlueprintEditor> BlueprintEditor);
+
+	FSlateIcon GetCommentIcon(TSharedRef<FPropertyCommentRow> Row);
+	FText GetCommentLabel(TSharedRef<FPropertyCommentRow> Row);
+	FText GetCommentTooltip(TSharedRef<FPropertyCommentRow> Row);
+
+	FSlateIcon ComputeCommentIcon(FPropertyCommentRow& Row);
+	FText ComputeCommentTooltip(FPropertyCommentRow& Row);
+
+	void OnClickComment(TSharedRef<FPropertyCommentRow> Row);
+	bool CanClickComment(TSharedRef<FPropertyCommentRow> Row);
 
 	void CloseCurrentOverlayWidget();
+	TSharedRef<SCommentEditOverlay> GetPooledOverlayWidget(const TSharedRef<SWindow>& Window);
 
 	TSharedPtr<SCommentEditOverlay> CurrentOverlayWidget;
+
+	/** Packages of the blueprints the open overlay edits, followed through renames. */
+	TSet<FName> OverlayPackageNames;
+
+	// Asset registry events are only recorded when they arrive, and handled together on the next tick
+	bool bPendingOverlayClose = false;
+	bool bPendingBlueprintInvalidation = false;
+	FTSTicker::FDelegateHandle AssetRegistryFlushHandle;
+
+	/** One overlay per window, re-targeted at each opened comment instead of being built again. */
+	TArray<TSharedRef<SCommentEditOverlay>> OverlayWidgetPool;
+	bool bSessionHooksRegistered = false;
+	bool bSearchTabRegistered = false;
+	FBlueprintResolveCache BlueprintResolveCache;
+	FInheritedCommentCache InheritedCommentCache;
+	TUniquePtr<FPropertyCommentRenameHandler> RenameHandler;
 };
\ No newline at end of file
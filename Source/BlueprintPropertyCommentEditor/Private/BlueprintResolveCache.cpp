@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintResolveCache.h"
+#include "PropertyCommentStats.h"
+#include "PropertyHandle.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+
+void FBlueprintResolveCache::GetBlueprintsFromPropertyHandle(const TSharedPtr<IPropertyHandle>& PropertyHandle, TArray<TWeakObjectPtr<UBlueprint>>& OutBlueprints)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::ResolveBlueprint);
+	SCOPE_CYCLE_COUNTER(STAT_PropertyComment_ResolveBlueprint);
+
+	check(IsInGameThread());
+
+	OutBlueprints.Reset();
+	if (!PropertyHandle || PropertyHandle->GetNumOuterObjects() == 0)
+	{
+		return;
+	}
+
+	OuterObjects.Reset();
+	PropertyHandle->GetOuterObjects(OuterObjects);
+	for (const UObject* Outer : OuterObjects)
+	{
+		if (!IsValid(Outer) || !Outer->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+		{
+			continue;
+		}
+
+		// A null value is a cached miss, a stale one means the blueprint went away since
+		UBlueprint* Blueprint = nullptr;
+		const TWeakObjectPtr<const UObject> Key{Outer};
+		if (const TWeakObjectPtr<UBlueprint>* FindResult = Entries.Find(Key); FindResult && !FindResult->IsStale())
+		{
+			INC_DWORD_STAT(STAT_PropertyComment_ResolveCacheHits);
+			Blueprint = FindResult->Get();
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_PropertyComment_ResolveCacheMisses);
+			Blueprint = FindOwningBlueprint(Outer);
+			Entries.Add(Key, Blueprint);
+		}
+
+		// Several components of one blueprint can be selected together
+		if (Blueprint)
+		{
+			OutBlueprints.AddUnique(Blueprint);
+		}
+	}
+}
+
+void FBlueprintResolveCache::Reset()
+{
+	Entries.Reset();
+}
+
+UBlueprint* FBlueprintResolveCache::FindOwningBlueprint(const UObject* Object)
+{
+	UBlueprint* Blueprint = nullptr;
+
+	for (const UObject* Outer = Object; IsValid(Outer); Outer = Outer->GetOuter())
+	{
+		const UClass* OuterClass = Outer->GetClass();
+		if (const UBlueprintGeneratedClass* BlueprintClass = Cast<UBlueprintGeneratedClass>(Outer))
+		{
+			Blueprint = UBlueprint::GetBlueprintFromClass(BlueprintClass);
+			break;
+		}
+
+		Blueprint = UBlueprint::GetBlueprintFromClass(OuterClass);
+		if (IsValid(Blueprint))
+		{
+			break;
+		}
+	}
+
+	return Blueprint;
+}
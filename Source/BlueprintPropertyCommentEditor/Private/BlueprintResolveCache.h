@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class IPropertyHandle;
+class UBlueprint;
+
+/**
+ * Maps the CDO / archetype objects shown in details panels to the blueprint that owns them.
+ * Keys and values are weak so the cache never keeps objects alive; it is reset whenever
+ * blueprints are compiled, reinstanced or removed.
+ */
+class FBlueprintResolveCache
+{
+public:
+	/**
+	 * Resolves the blueprints of all the objects the handle edits in one pass, so rows of a
+	 * multi-selection get every selected blueprint. Objects without a blueprint are skipped.
+	 */
+	void GetBlueprintsFromPropertyHandle(const TSharedPtr<IPropertyHandle>& PropertyHandle, TArray<TWeakObjectPtr<UBlueprint>>& OutBlueprints);
+	void Reset();
+
+private:
+	static UBlueprint* FindOwningBlueprint(const UObject* Object);
+
+	TMap<TWeakObjectPtr<const UObject>, TWeakObjectPtr<UBlueprint>> Entries;
+
+	// Reused between lookups so that resolving an uncached object does not allocate every time
+	TArray<UObject*> OuterObjects;
+};
@@ -0,0 +1,271 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/PropertyCommentBenchmarkCommandlet.h"
+#include "BlueprintPropertyComment.h"
+#include "BlueprintPropertyCommentEditor.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentRow.h"
+#include "PropertyCommentSyntheticBlueprint.h"
+#include "IPropertyRowGenerator.h"
+#include "PropertyEditorModule.h"
+#include "PropertyHandle.h"
+#include "Engine/Blueprint.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	struct FBenchmarkResult
+	{
+		const TCHAR* Name = nullptr;
+		int64 NumCalls = 0;
+		double TotalSeconds = 0.0;
+		uint64 NumAllocations = 0;
+	};
+
+	uint64 GetNumAllocations()
+	{
+#if !UE_BUILD_SHIPPING
+		return FMalloc::TotalMallocCalls.Load() + FMalloc::TotalReallocCalls.Load();
+#else
+		return 0;
+#endif
+	}
+
+	template <typename FuncType>
+	FBenchmarkResult Measure(const TCHAR* Name, int64 NumCalls, FuncType&& Func)
+	{
+		const uint64 StartAllocations = GetNumAllocations();
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		Func();
+
+		FBenchmarkResult Result;
+		Result.Name = Name;
+		Result.NumCalls = NumCalls;
+		Result.TotalSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		Result.NumAllocations = GetNumAllocations() - StartAllocations;
+		return Result;
+	}
+}
+
+UPropertyCommentBenchmarkCommandlet::UPropertyCommentBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPropertyCommentBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const auto GetIntParam = [&ParamValues](const TCHAR* Name, int32 Default)
+	{
+		int32 Value = Default;
+		if (const FString* StringValue = ParamValues.Find(Name))
+		{
+			LexFromString(Value, **StringValue);
+		}
+		return FMath::Max(0, Value);
+	};
+
+	const int32 NumProperties = GetIntParam(TEXT("properties"), 200);
+	const int32 Depth = GetIntParam(TEXT("depth"), 3);
+	const int32 NumElements = GetIntParam(TEXT("elements"), 4);
+	const int32 NumComments = GetIntParam(TEXT("comments"), 50);
+	const int32 NumFrames = FMath::Max(1, GetIntParam(TEXT("frames"), 100));
+
+	const FString* OutputValue = ParamValues.Find(TEXT("output"));
+	const FString OutputFile = OutputValue
+		? *OutputValue
+		: FPaths::ProjectSavedDir() / TEXT("PropertyComments") / TEXT("Benchmark.json");
+
+	FBlueprintPropertyCommentEditorModule& Module = FModuleManager::LoadModuleChecked<FBlueprintPropertyCommentEditorModule>("BlueprintPropertyCommentEditor");
+	FPropertyEditorModule& PropertyEditor = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+
+	const TStrongObjectPtr<UBlueprint> Blueprint{PropertyCommentSyntheticBlueprint::Create(NumProperties, Depth, NumElements)};
+	UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
+
+	// The row generator builds the same property nodes a details panel would, without any widgets
+	const TSharedRef<IPropertyRowGenerator> RowGenerator = PropertyEditor.CreatePropertyRowGenerator(FPropertyRowGeneratorArgs{});
+	RowGenerator->SetObjects({DefaultObject});
+
+	TArray<TSharedPtr<IPropertyHandle>> Handles;
+	PropertyCommentSyntheticBlueprint::GatherPropertyHandles(RowGenerator->GetRootTreeNodes(), Handles);
+	const int32 NumRows = Handles.Num();
+	if (NumRows == 0)
+	{
+		UE_LOG(LogBlueprintPropertyComment, Error, TEXT("The synthetic blueprint did not produce any property rows"));
+		return 1;
+	}
+
+	TArray<FBenchmarkResult> Results;
+	TArray<FPropertyCommentPath> Paths;
+	Paths.Reserve(NumRows);
+	Results.Add(Measure(TEXT("GetPropertyPathRecursive"), NumRows, [&Handles, &Paths]()
+	{
+		for (const TSharedPtr<IPropertyHandle>& Handle : Handles)
+		{
+			Paths.Add(FPropertyCommentRow::GetPropertyPathRecursive(Handle));
+		}
+	}));
+
+	UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetOrCreatePropertyCommentExtension(Blueprint.Get());
+	const int32 CommentStride = FMath::Max(1, NumRows / FMath::Max(1, NumComments));
+	for (int32 Index = 0; Index < NumComments && Index * CommentStride < NumRows; ++Index)
+	{
+		Extension->AddComment(Paths[Index * CommentStride], FText::AsCultureInvariant(FString::Printf(TEXT("Benchmark comment %d"), Index)));
+	}
+
+	TArray<TSharedRef<FPropertyCommentRow>> Rows;
+	Rows.Reserve(NumRows);
+	const auto EvaluatePanel = [&Module, &Rows]()
+	{
+		for (const TSharedRef<FPropertyCommentRow>& Row : Rows)
+		{
+			Module.GetCommentIcon(Row);
+			Module.GetCommentTooltip(Row);
+			Module.CanClickComment(Row);
+		}
+	};
+
+	Results.Add(Measure(TEXT("PanelFirstFrame"), NumRows, [&Module, &Handles, &Rows, &EvaluatePanel]()
+	{
+		for (const TSharedPtr<IPropertyHandle>& Handle : Handles)
+		{
+			Rows.Add(MakeShared<FPropertyCommentRow>(Handle, Module.BlueprintResolveCache));
+		}
+		EvaluatePanel();
+	}));
+
+	Results.Add(Measure(TEXT("PanelWarmFrame"), NumFrames, [NumFrames, &EvaluatePanel]()
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			EvaluatePanel();
+		}
+	}));
+
+	Results.Add(Measure(TEXT("GetCommentIcon"), int64{NumRows} * NumFrames, [NumFrames, &Module, &Rows]()
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (const TSharedRef<FPropertyCommentRow>& Row : Rows)
+			{
+				Module.GetCommentIcon(Row);
+			}
+		}
+	}));
+
+	Results.Add(Measure(TEXT("GetCommentTooltip"), int64{NumRows} * NumFrames, [NumFrames, &Module, &Rows]()
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (const TSharedRef<FPropertyCommentRow>& Row : Rows)
+			{
+				Module.GetCommentTooltip(Row);
+			}
+		}
+	}));
+
+	Results.Add(Measure(TEXT("CanClickComment"), int64{NumRows} * NumFrames, [NumFrames, &Module, &Rows]()
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (const TSharedRef<FPropertyCommentRow>& Row : Rows)
+			{
+				Module.CanClickComment(Row);
+			}
+		}
+	}));
+
+	Results.Add(Measure(TEXT("ExtensionFindComment"), int64{NumRows} * NumFrames, [NumFrames, Extension, &Paths]()
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (const FPropertyCommentPath& Path : Paths)
+			{
+				Extension->FindComment(Path);
+			}
+		}
+	}));
+
+	// One query per keystroke of a details filter, the token index is already built by the first one
+	TArray<FPropertyCommentPath> MatchingPaths;
+	Extension->FindCommentsMatching(TEXT("benchmark"), MatchingPaths);
+	Results.Add(Measure(TEXT("ExtensionFindCommentsMatching"), NumFrames, [NumFrames, Extension, &MatchingPaths]()
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			MatchingPaths.Reset();
+			Extension->FindCommentsMatching(TEXT("benchmark comm"), MatchingPaths);
+		}
+	}));
+
+	// What a frame costs right after a compile, and right after someone edits a comment
+	Results.Add(Measure(TEXT("PanelFrameAfterCompile"), 1, [&Module, &EvaluatePanel]()
+	{
+		Module.InvalidateResolvedBlueprints();
+		EvaluatePanel();
+	}));
+
+	Results.Add(Measure(TEXT("PanelFrameAfterCommentChange"), 1, [Extension, &Paths, &EvaluatePanel]()
+	{
+		Extension->AddComment(Paths[0], FText::AsCultureInvariant(TEXT("Changed benchmark comment")));
+		EvaluatePanel();
+	}));
+
+	bool bAllocationsTracked = false;
+	for (const FBenchmarkResult& Result : Results)
+	{
+		bAllocationsTracked |= Result.NumAllocations > 0;
+	}
+
+	FString Output;
+	const TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Output);
+	Writer->WriteObjectStart();
+	Writer->WriteObjectStart(TEXT("parameters"));
+	Writer->WriteValue(TEXT("properties"), NumProperties);
+	Writer->WriteValue(TEXT("depth"), Depth);
+	Writer->WriteValue(TEXT("elements"), NumElements);
+	Writer->WriteValue(TEXT("comments"), Extension->GetNumComments());
+	Writer->WriteValue(TEXT("frames"), NumFrames);
+	Writer->WriteValue(TEXT("rows"), NumRows);
+	Writer->WriteObjectEnd();
+	Writer->WriteValue(TEXT("allocations_tracked"), bAllocationsTracked);
+	Writer->WriteArrayStart(TEXT("results"));
+	for (const FBenchmarkResult& Result : Results)
+	{
+		const double NumCalls = static_cast<double>(FMath::Max<int64>(1, Result.NumCalls));
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), FString{Result.Name});
+		Writer->WriteValue(TEXT("calls"), Result.NumCalls);
+		Writer->WriteValue(TEXT("total_ms"), Result.TotalSeconds * 1000.0);
+		Writer->WriteValue(TEXT("ns_per_call"), Result.TotalSeconds * 1e9 / NumCalls);
+		Writer->WriteValue(TEXT("allocations"), static_cast<int64>(Result.NumAllocations));
+		Writer->WriteValue(TEXT("allocations_per_call"), static_cast<double>(Result.NumAllocations) / NumCalls);
+		Writer->WriteObjectEnd();
+
+		UE_LOG(LogBlueprintPropertyComment, Display, TEXT("%-28s %10lld calls %12.1f ns/call %10llu allocations"),
+			Result.Name, Result.NumCalls, Result.TotalSeconds * 1e9 / NumCalls, Result.NumAllocations);
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(Output, *OutputFile))
+	{
+		UE_LOG(LogBlueprintPropertyComment, Error, TEXT("Could not write %s"), *OutputFile);
+		return 1;
+	}
+
+	UE_LOG(LogBlueprintPropertyComment, Display, TEXT("Wrote benchmark results for %d rows to %s"), NumRows, *OutputFile);
+	return 0;
+}
@@ -0,0 +1,40 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PropertyCommentBenchmarkCommandlet.generated.h"
+
+/**
+ * Times the details panel row hot path against a synthetic transient blueprint and writes the
+ * results as JSON. Runs headless, e.g. UnrealEditor-Cmd <Project> -run=PropertyCommentBenchmark -nullrhi
+ *
+ * Usage: -run=PropertyCommentBenchmark [-properties=200] [-depth=3] [-elements=4] [-comments=50]
+ *        [-frames=100] [-output=<file>]
+ *
+ * -properties  Number of member variables. A quarter are nested structs, a quarter arrays of them.
+ * -depth       Nesting depth of the struct variables.
+ * -elements    Number of elements in every array variable.
+ * -comments    Number of rows that get a comment, spread evenly over the panel.
+ * -frames      Number of warm frames evaluating every row.
+ * -output      JSON file to write, defaults to Saved/PropertyComments/Benchmark.json.
+ *
+ * Allocation counts come from FMalloc::TotalMallocCalls, which stays at zero unless the active
+ * allocator counts its calls. "allocations_tracked" in the output tells whether it did.
+ *
+ * Only measures. What the rows display is checked by the BlueprintPropertyComment.Editor.CommentRow
+ * automation tests, on the same synthetic blueprint.
+ */
+UCLASS()
+class UPropertyCommentBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPropertyCommentBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/PropertyCommentTransferCommandlet.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentTransfer.h"
+#include "Algo/Transform.h"
+
+UPropertyCommentTransferCommandlet::UPropertyCommentTransferCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPropertyCommentTransferCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	FPropertyCommentTransferOptions Options;
+	Options.bAllBlueprints = Switches.Contains(TEXT("all"));
+	Options.bSavePackages = !Switches.Contains(TEXT("nosave"));
+	if (const FString* IntervalValue = ParamValues.Find(TEXT("gcinterval")))
+	{
+		LexFromString(Options.PackagesPerGarbageCollection, **IntervalValue);
+	}
+	if (const FString* PathsValue = ParamValues.Find(TEXT("paths")))
+	{
+		TArray<FString> Paths;
+		PathsValue->ParseIntoArray(Paths, TEXT("+"));
+		Algo::Transform(Paths, Options.PackagePaths, [](const FString& Path) { return FName{Path}; });
+	}
+
+	FPropertyCommentTransferStats Stats;
+	bool bSucceeded = false;
+	if (const FString* ExportFile = ParamValues.Find(TEXT("export")))
+	{
+		bSucceeded = FPropertyCommentTransfer::Export(*ExportFile, Options, Stats);
+		UE_LOG(LogBlueprintPropertyComment, Display, TEXT("Exported %d comments from %d blueprints to %s"), Stats.NumComments, Stats.NumBlueprints, **ExportFile);
+	}
+	else if (const FString* ImportFile = ParamValues.Find(TEXT("import")))
+	{
+		bSucceeded = FPropertyCommentTransfer::Import(*ImportFile, Options, Stats);
+		UE_LOG(LogBlueprintPropertyComment, Display, TEXT("Imported %d comments into %d blueprints from %s, %d blueprints failed"),
+			Stats.NumComments, Stats.NumBlueprints, **ImportFile, Stats.NumFailedBlueprints);
+	}
+	else
+	{
+		UE_LOG(LogBlueprintPropertyComment, Error, TEXT("Specify either -export=<file> or -import=<file>"));
+	}
+
+	return bSucceeded && Stats.NumFailedBlueprints == 0 ? 0 : 1;
+}
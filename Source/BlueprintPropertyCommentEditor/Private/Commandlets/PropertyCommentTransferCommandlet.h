@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PropertyCommentTransferCommandlet.generated.h"
+
+/**
+ * Exports or imports every property comment of the project through FPropertyCommentTransfer.
+ *
+ * Usage: -run=PropertyCommentTransfer (-export=<file> | -import=<file>) [-all] [-nosave]
+ *        [-paths=/Game/A+/Game/B] [-gcinterval=64]
+ */
+UCLASS()
+class UPropertyCommentTransferCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPropertyCommentTransferCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/PropertyCommentValidateCommandlet.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentPackageHash.h"
+#include "PropertyCommentPackageUtils.h"
+#include "PropertyCommentResolver.h"
+#include "PropertyCommentSettings.h"
+#include "Algo/Transform.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Blueprint.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	struct FValidationJob
+	{
+		FName PackageName;
+		FString SavedHash;
+		UBlueprint* Blueprint = nullptr;
+		UPropertyCommentExtension* Extension = nullptr;
+		TUniquePtr<FPropertyCommentResolver> Resolver;
+		TArray<FPropertyCommentPath> Paths;
+		TArray<FPropertyCommentPath> Orphans;
+	};
+}
+
+UPropertyCommentValidateCommandlet::UPropertyCommentValidateCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPropertyCommentValidateCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const bool bPrune = Switches.Contains(TEXT("prune"));
+	// Sidecar edits never change the package, so its hash cannot tell whether the comments were validated
+	const bool bSidecarStorage = GetDefault<UPropertyCommentSettings>()->Storage == EPropertyCommentStorage::Sidecar;
+	const bool bIncremental = Switches.Contains(TEXT("incremental")) && !bSidecarStorage;
+	if (bSidecarStorage && Switches.Contains(TEXT("incremental")))
+	{
+		UE_LOG(LogBlueprintPropertyComment, Display, TEXT("Comments are stored in sidecar files, -incremental is ignored"));
+	}
+	const bool bAllBlueprints = Switches.Contains(TEXT("all"));
+	const bool bFailOnOrphans = Switches.Contains(TEXT("failonorphans"));
+
+	int32 BatchSize = 64;
+	if (const FString* BatchSizeValue = ParamValues.Find(TEXT("batchsize")))
+	{
+		LexFromString(BatchSize, **BatchSizeValue);
+	}
+	BatchSize = FMath::Max(1, BatchSize);
+
+	const FString* CacheFileValue = ParamValues.Find(TEXT("cachefile"));
+	const FString CacheFile = CacheFileValue
+		? *CacheFileValue
+		: FPaths::ProjectSavedDir() / TEXT("PropertyComments") / TEXT("ValidateCache.txt");
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FName> PackagePaths;
+	if (const FString* PathsValue = ParamValues.Find(TEXT("paths")))
+	{
+		TArray<FString> Paths;
+		PathsValue->ParseIntoArray(Paths, TEXT("+"));
+		Algo::Transform(Paths, PackagePaths, [](const FString& Path) { return FName{Path}; });
+	}
+
+	TArray<FAssetData> Assets;
+	PropertyCommentPackageUtils::GetCommentedBlueprints(AssetRegistry, bAllBlueprints, PackagePaths, Assets);
+
+	// Packages that were clean when last validated and have not been saved since can be skipped
+	TMap<FName, FString> ValidatedHashes = bIncremental ? PropertyCommentPackageHash::LoadFile(CacheFile) : TMap<FName, FString>{};
+	int32 NumSkipped = 0;
+	TArray<TPair<FAssetData, FString>> AssetsToValidate;
+	for (FAssetData& AssetData : Assets)
+	{
+		FString SavedHash = PropertyCommentPackageHash::Get(AssetRegistry, AssetData.PackageName);
+		const FString* ValidatedHash = ValidatedHashes.Find(AssetData.PackageName);
+		if (bIncremental && ValidatedHash && !SavedHash.IsEmpty() && *ValidatedHash == SavedHash)
+		{
+			++NumSkipped;
+			continue;
+		}
+		AssetsToValidate.Emplace(MoveTemp(AssetData), MoveTemp(SavedHash));
+	}
+
+	UE_LOG(LogBlueprintPropertyComment, Display, TEXT("Validating property comments of %d blueprints (%d unchanged since last run)"),
+		AssetsToValidate.Num(), NumSkipped);
+
+	int32 NumOrphans = 0;
+	int32 NumPruned = 0;
+	for (int32 BatchStart = 0; BatchStart < AssetsToValidate.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, AssetsToValidate.Num());
+
+		// Loading and gathering the layouts has to happen on the game thread
+		TArray<FValidationJob> Jobs;
+		Jobs.Reserve(BatchEnd - BatchStart);
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			const FAssetData& AssetData = AssetsToValidate[Index].Key;
+			UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+			UPropertyCommentExtension* Extension = IsValid(Blueprint) ? UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint) : nullptr;
+			if (!IsValid(Extension))
+			{
+				ValidatedHashes.Add(AssetData.PackageName, AssetsToValidate[Index].Value);
+				continue;
+			}
+
+			FValidationJob& Job = Jobs.AddDefaulted_GetRef();
+			Job.PackageName = AssetData.PackageName;
+			Job.SavedHash = AssetsToValidate[Index].Value;
+			Job.Blueprint = Blueprint;
+			Job.Extension = Extension;
+			Job.Resolver = MakeUnique<FPropertyCommentResolver>(Blueprint);
+			Extension->ForEachCommentedPath([&Job](const FPropertyCommentPath& PropertyPath)
+			{
+				Job.Paths.Add(PropertyPath);
+			});
+		}
+
+		// Resolving only reads property layouts, so the batch can be checked in parallel
+		ParallelFor(Jobs.Num(), [&Jobs](int32 JobIndex)
+		{
+			FValidationJob& Job = Jobs[JobIndex];
+			for (const FPropertyCommentPath& PropertyPath : Job.Paths)
+			{
+				if (!Job.Resolver->CanResolve(PropertyPath))
+				{
+					Job.Orphans.Add(PropertyPath);
+				}
+			}
+		});
+
+		for (FValidationJob& Job : Jobs)
+		{
+			if (Job.Orphans.Num() == 0)
+			{
+				ValidatedHashes.Add(Job.PackageName, Job.SavedHash);
+				continue;
+			}
+
+			NumOrphans += Job.Orphans.Num();
+			for (const FPropertyCommentPath& Orphan : Job.Orphans)
+			{
+				UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("%s: comment on '%s' does not match any property"),
+					*Job.PackageName.ToString(), *Orphan.ToString());
+			}
+
+			if (bPrune)
+			{
+				for (const FPropertyCommentPath& Orphan : Job.Orphans)
+				{
+					Job.Extension->RemoveComment(Orphan);
+				}
+
+				// Saving changes the hash, so pruned packages are checked again on the next run
+				const bool bMarkedDirty = Job.Extension->MarkCommentsDirty();
+				if (Job.Extension->IsStoredInSidecar() ? bMarkedDirty : PropertyCommentPackageUtils::SavePackage(Job.Blueprint->GetOutermost()))
+				{
+					NumPruned += Job.Orphans.Num();
+				}
+			}
+		}
+
+		Jobs.Reset();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	if (bIncremental)
+	{
+		PropertyCommentPackageHash::SaveFile(CacheFile, ValidatedHashes);
+	}
+
+	UE_LOG(LogBlueprintPropertyComment, Display, TEXT("Found %d orphaned comments, pruned %d"), NumOrphans, NumPruned);
+	return bFailOnOrphans && NumOrphans > NumPruned ? 1 : 0;
+}
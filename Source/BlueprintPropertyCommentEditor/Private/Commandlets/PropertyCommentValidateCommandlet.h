@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PropertyCommentValidateCommandlet.generated.h"
+
+/**
+ * Reports, and optionally removes, comments whose property path no longer exists in the blueprint.
+ *
+ * Usage: -run=PropertyCommentValidate [-prune] [-incremental] [-all] [-failonorphans]
+ *        [-batchsize=64] [-paths=/Game/A+/Game/B] [-cachefile=<path>]
+ *
+ * -prune          Remove orphaned comments and resave the affected packages.
+ * -incremental    Skip packages whose saved hash matches the one recorded by the last clean run.
+ *                 Ignored with sidecar storage, where comment edits leave the package unchanged.
+ * -all            Check every blueprint, including the ones whose tags report no comments.
+ * -failonorphans  Return a non-zero exit code when orphans are found and not pruned.
+ */
+UCLASS()
+class UPropertyCommentValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPropertyCommentValidateCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
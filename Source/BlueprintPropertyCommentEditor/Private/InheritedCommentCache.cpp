@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InheritedCommentCache.h"
+#include "PropertyCommentExtension.h"
+#include "Engine/Blueprint.h"
+
+const UPropertyCommentExtension* FInheritedCommentView::FindOwner(const FPropertyCommentPath& PropertyPath) const
+{
+	if (const UPropertyCommentExtension* Extension = SoleExtension.Get())
+	{
+		return Extension->HasComment(PropertyPath) ? Extension : nullptr;
+	}
+
+	const TWeakObjectPtr<const UPropertyCommentExtension>* Owner = Owners.Find(PropertyPath);
+	return Owner ? Owner->Get() : nullptr;
+}
+
+const FText* FInheritedCommentView::FindComment(const FPropertyCommentPath& PropertyPath) const
+{
+	const UPropertyCommentExtension* Owner = FindOwner(PropertyPath);
+	return Owner ? Owner->FindComment(PropertyPath) : nullptr;
+}
+
+bool FInheritedCommentView::HasComment(const FPropertyCommentPath& PropertyPath) const
+{
+	return FindOwner(PropertyPath) != nullptr;
+}
+
+int32 FInheritedCommentView::GetNumCommentsBelow(const FPropertyCommentPath& PropertyPath) const
+{
+	if (const UPropertyCommentExtension* Extension = SoleExtension.Get())
+	{
+		return Extension->GetNumCommentsBelow(PropertyPath);
+	}
+
+	const int32* NumComments = NumCommentsBelow.Find(PropertyPath);
+	return NumComments ? *NumComments : 0;
+}
+
+bool FInheritedCommentView::IsEmpty() const
+{
+	return !SoleExtension.IsValid() && Owners.Num() == 0;
+}
+
+void FInheritedCommentView::Merge(const FInheritedCommentView& Parent)
+{
+	if (const UPropertyCommentExtension* Extension = Parent.SoleExtension.Get())
+	{
+		Overlay(Extension);
+	}
+	else
+	{
+		Owners = Parent.Owners;
+	}
+}
+
+void FInheritedCommentView::Overlay(const UPropertyCommentExtension* Extension)
+{
+	// Only the paths are needed, which keeps the texts of the extension unloaded
+	Owners.Reserve(Owners.Num() + Extension->GetNumComments());
+	Extension->ForEachCommentedPath([this, Extension](const FPropertyCommentPath& PropertyPath)
+	{
+		Owners.Add(PropertyPath, Extension);
+	});
+}
+
+void FInheritedCommentView::RebuildNumCommentsBelow()
+{
+	NumCommentsBelow.Reset();
+	for (const TPair<FPropertyCommentPath, TWeakObjectPtr<const UPropertyCommentExtension>>& Pair : Owners)
+	{
+		FPropertyCommentPath Prefix;
+		for (int32 Index = 0; Index + 1 < Pair.Key.Segments.Num(); ++Index)
+		{
+			Prefix.Segments.Add(Pair.Key.Segments[Index]);
+			++NumCommentsBelow.FindOrAdd(Prefix);
+		}
+	}
+}
+
+FInheritedCommentCache::FInheritedCommentCache()
+	: EmptyView(MakeShared<FInheritedCommentView>())
+{
+	UPropertyCommentExtension::OnCommentsChanged().AddRaw(this, &FInheritedCommentCache::HandleCommentsChanged);
+}
+
+FInheritedCommentCache::~FInheritedCommentCache()
+{
+	UPropertyCommentExtension::OnCommentsChanged().RemoveAll(this);
+}
+
+TSharedRef<const FInheritedCommentView> FInheritedCommentCache::GetView(const UBlueprint* Blueprint)
+{
+	if (const FEntry* Existing = Entries.Find(Blueprint))
+	{
+		return Existing->View;
+	}
+
+	TSharedRef<const FInheritedCommentView> ParentView = EmptyView;
+	TArray<TWeakObjectPtr<const UBlueprint>> Chain{Blueprint};
+	if (const UBlueprint* ParentBlueprint = GetParentBlueprint(Blueprint))
+	{
+		// Builds the views of the parents first, each of them once
+		ParentView = GetView(ParentBlueprint);
+		Chain.Append(Entries.FindChecked(ParentBlueprint).Chain);
+	}
+
+	TSharedRef<const FInheritedCommentView> View = ParentView;
+	const UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
+	if (IsValid(Extension) && Extension->GetNumComments() > 0)
+	{
+		TSharedRef<FInheritedCommentView> MergedView = MakeShared<FInheritedCommentView>();
+		if (ParentView->IsEmpty())
+		{
+			MergedView->SoleExtension = Extension;
+		}
+		else
+		{
+			MergedView->Merge(*ParentView);
+			MergedView->Overlay(Extension);
+			MergedView->RebuildNumCommentsBelow();
+		}
+		View = MergedView;
+	}
+
+	Entries.Add(Blueprint, FEntry{View, MoveTemp(Chain)});
+	return View;
+}
+
+void FInheritedCommentCache::InvalidateReparented()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const TArray<TWeakObjectPtr<const UBlueprint>>& Chain = It->Value.Chain;
+
+		bool bChainChanged = !It->Key.IsValid();
+		for (int32 Index = 0; !bChainChanged && Index < Chain.Num(); ++Index)
+		{
+			const UBlueprint* Blueprint = Chain[Index].Get();
+			const UBlueprint* ParentBlueprint = Chain.IsValidIndex(Index + 1) ? Chain[Index + 1].Get() : nullptr;
+			bChainChanged = !Blueprint || GetParentBlueprint(Blueprint) != ParentBlueprint;
+		}
+
+		if (bChainChanged)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FInheritedCommentCache::Reset()
+{
+	Entries.Reset();
+}
+
+void FInheritedCommentCache::HandleCommentsChanged(UPropertyCommentExtension* Extension, const FPropertyCommentPath* ChangedPath)
+{
+	const UBlueprint* Blueprint = Extension->GetBlueprint();
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Chain.Contains(Blueprint))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+const UBlueprint* FInheritedCommentCache::GetParentBlueprint(const UBlueprint* Blueprint)
+{
+	return UBlueprint::GetBlueprintFromClass(Blueprint->ParentClass);
+}
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PropertyCommentPath.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+class UPropertyCommentExtension;
+
+/**
+ * The comments visible on a blueprint: its own, plus the ones its parent blueprints left on the
+ * properties it inherits. A child's comment overrides the comment of a parent on the same path.
+ * Views only map paths to the extension holding the comment; the texts stay in the extensions.
+ */
+class FInheritedCommentView
+{
+public:
+	/** Extension holding the comment visible at the path, or null. */
+	const UPropertyCommentExtension* FindOwner(const FPropertyCommentPath& PropertyPath) const;
+	const FText* FindComment(const FPropertyCommentPath& PropertyPath) const;
+	bool HasComment(const FPropertyCommentPath& PropertyPath) const;
+	int32 GetNumCommentsBelow(const FPropertyCommentPath& PropertyPath) const;
+	bool IsEmpty() const;
+
+private:
+	friend class FInheritedCommentCache;
+
+	void Merge(const FInheritedCommentView& Parent);
+	void Overlay(const UPropertyCommentExtension* Extension);
+	void RebuildNumCommentsBelow();
+
+	// Set when a single blueprint of the hierarchy has comments, which is the common case. Lookups
+	// then go straight to its extension instead of copying its paths.
+	TWeakObjectPtr<const UPropertyCommentExtension> SoleExtension;
+
+	TMap<FPropertyCommentPath, TWeakObjectPtr<const UPropertyCommentExtension>> Owners;
+	TMap<FPropertyCommentPath, int32> NumCommentsBelow;
+};
+
+/**
+ * Memoizes one FInheritedCommentView per blueprint, each built on top of the view of its parent
+ * blueprint, so a lookup costs the same no matter how deep the hierarchy is. Blueprints without
+ * comments of their own share the view of their parent.
+ *
+ * A comment change drops the views of the changed blueprint and its children. Reparenting only
+ * drops the views whose chain of parent blueprints is not the one they were built from.
+ */
+class FInheritedCommentCache
+{
+public:
+	FInheritedCommentCache();
+	~FInheritedCommentCache();
+
+	TSharedRef<const FInheritedCommentView> GetView(const UBlueprint* Blueprint);
+
+	/** Call after blueprints were compiled or reinstanced. */
+	void InvalidateReparented();
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		TSharedRef<const FInheritedCommentView> View;
+
+		/** The blueprint followed by its parent blueprints, as they were when the view was built. */
+		TArray<TWeakObjectPtr<const UBlueprint>> Chain;
+	};
+
+	void HandleCommentsChanged(UPropertyCommentExtension* Extension, const FPropertyCommentPath* ChangedPath);
+	static const UBlueprint* GetParentBlueprint(const UBlueprint* Blueprint);
+
+	TMap<TWeakObjectPtr<const UBlueprint>, FEntry> Entries;
+	TSharedRef<const FInheritedCommentView> EmptyView;
+};
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentPackageHash.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/FileHelper.h"
+
+namespace PropertyCommentPackageHash
+{
+	FString Get(const IAssetRegistry& AssetRegistry, FName PackageName)
+	{
+		const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+		return PackageData.IsSet() ? LexToString(PackageData->GetPackageSavedHash()) : FString{};
+	}
+
+	TMap<FName, FString> LoadFile(const FString& Filename)
+	{
+		TMap<FName, FString> Hashes;
+
+		TArray<FString> Lines;
+		if (FFileHelper::LoadFileToStringArray(Lines, *Filename))
+		{
+			Hashes.Reserve(Lines.Num());
+			for (const FString& Line : Lines)
+			{
+				FString PackageName;
+				FString Hash;
+				if (Line.Split(TEXT("\t"), &PackageName, &Hash))
+				{
+					Hashes.Add(FName{PackageName}, MoveTemp(Hash));
+				}
+			}
+		}
+
+		return Hashes;
+	}
+
+	bool SaveFile(const FString& Filename, const TMap<FName, FString>& Hashes)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(Hashes.Num());
+		for (const TPair<FName, FString>& Pair : Hashes)
+		{
+			Lines.Add(FString::Printf(TEXT("%s\t%s"), *Pair.Key.ToString(), *Pair.Value));
+		}
+		Lines.Sort();
+
+		return FFileHelper::SaveStringArrayToFile(Lines, *Filename);
+	}
+}
@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+
+namespace PropertyCommentPackageHash
+{
+	/** Hash of the package as last saved, according to the asset registry. Empty if unknown. */
+	FString Get(const IAssetRegistry& AssetRegistry, FName PackageName);
+
+	/** Reads a "PackageName<tab>Hash" per line file. Missing files yield an empty map. */
+	TMap<FName, FString> LoadFile(const FString& Filename);
+	bool SaveFile(const FString& Filename, const TMap<FName, FString>& Hashes);
+}
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentPackageUtils.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentAssetTags.h"
+#include "PropertyCommentExtension.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+namespace PropertyCommentPackageUtils
+{
+	FARFilter MakeBlueprintFilter(const TArray<FName>& PackagePaths)
+	{
+		FARFilter Filter;
+		Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+		Filter.bRecursiveClasses = true;
+		if (PackagePaths.Num() > 0)
+		{
+			Filter.PackagePaths = PackagePaths;
+			Filter.bRecursivePaths = true;
+		}
+		return Filter;
+	}
+
+	void GetCommentedBlueprints(const IAssetRegistry& AssetRegistry, bool bAllBlueprints, const TArray<FName>& PackagePaths, TArray<FAssetData>& OutAssets)
+	{
+		const int32 FirstAsset = OutAssets.Num();
+		AssetRegistry.GetAssets(MakeBlueprintFilter(PackagePaths), OutAssets);
+		if (bAllBlueprints)
+		{
+			return;
+		}
+
+		// Tags with a count of 0 are the only ones that rule a blueprint out
+		const TSet<FName> SidecarBlueprints = GetSidecarBlueprints();
+		int32 NumUntagged = 0;
+		for (int32 Index = OutAssets.Num() - 1; Index >= FirstAsset; --Index)
+		{
+			const FAssetData& AssetData = OutAssets[Index];
+			NumUntagged += PropertyCommentAssetTags::HasCommentCount(AssetData) ? 0 : 1;
+			if (!MayHaveComments(AssetData, SidecarBlueprints))
+			{
+				OutAssets.RemoveAt(Index, 1, false);
+			}
+		}
+
+		if (NumUntagged > 0)
+		{
+			UE_LOG(LogBlueprintPropertyComment, Display, TEXT("%d blueprints were saved before the comment tags existed and have to be loaded to find their comments. Resave them to skip the load."),
+				NumUntagged);
+		}
+	}
+
+	TSet<FName> GetSidecarBlueprints()
+	{
+		TArray<FSoftObjectPath> Blueprints;
+		UPropertyCommentExtension::GetSidecarBlueprints(Blueprints);
+
+		TSet<FName> ObjectPaths;
+		ObjectPaths.Reserve(Blueprints.Num());
+		for (const FSoftObjectPath& Blueprint : Blueprints)
+		{
+			ObjectPaths.Add(FName{*Blueprint.ToString()});
+		}
+		return ObjectPaths;
+	}
+
+	bool MayHaveComments(const FAssetData& AssetData, const TSet<FName>& SidecarBlueprints)
+	{
+		return !PropertyCommentAssetTags::HasCommentCount(AssetData) || PropertyCommentAssetTags::GetCommentCount(AssetData) > 0
+			|| SidecarBlueprints.Contains(AssetData.ObjectPath);
+	}
+
+	bool SavePackage(UPackage* Package)
+	{
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		if (IFileManager::Get().IsReadOnly(*Filename))
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Cannot save %s, the file is read only. Check it out and run again."), *Filename);
+			return false;
+		}
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.Error = GWarn;
+		return UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs);
+	}
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AssetRegistry/ARFilter.h"
+
+class IAssetRegistry;
+class UPackage;
+
+namespace PropertyCommentPackageUtils
+{
+	/** Filter for every blueprint, optionally below the given package paths. */
+	FARFilter MakeBlueprintFilter(const TArray<FName>& PackagePaths = {});
+
+	/**
+	 * The blueprints that may have comments: those whose tags report some, those named by sidecar
+	 * files, whose tags are only updated when the package is saved, and those saved before the tags
+	 * existed, which have to be loaded to find out. bAllBlueprints returns every blueprint.
+	 */
+	void GetCommentedBlueprints(const IAssetRegistry& AssetRegistry, bool bAllBlueprints, const TArray<FName>& PackagePaths, TArray<FAssetData>& OutAssets);
+
+	/** Object paths of the blueprints named by sidecar files. Empty unless sidecar storage is enabled. */
+	TSet<FName> GetSidecarBlueprints();
+
+	/** False only when the tags of the blueprint report no comments and no sidecar file names it. */
+	bool MayHaveComments(const FAssetData& AssetData, const TSet<FName>& SidecarBlueprints);
+
+	/** Saves the package to its existing file. Fails with a warning if the file is read only. */
+	bool SavePackage(UPackage* Package);
+}
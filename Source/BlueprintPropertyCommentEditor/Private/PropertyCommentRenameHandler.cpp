@@ -0,0 +1,389 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentRenameHandler.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentPackageUtils.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Engine/UserDefinedStruct.h"
+#include "HAL/FileManager.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	constexpr uint32 PendingRenamesMagic = 0x5043524E; // "PCRN"
+
+	// Bump when the layout written by SavePendingRenames changes, older files are then dropped
+	constexpr int32 PendingRenamesVersion = 1;
+
+	FString GetPendingRenamesFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("PropertyComments") / TEXT("PendingRenames.bin");
+	}
+
+	/**
+	 * Walks the hard package referencers of PackageName breadth first. Visit returns whether the
+	 * referencer's own referencers should be visited as well.
+	 */
+	void ForEachReferencer(FName PackageName, TFunctionRef<bool(const FAssetData& Referencer, FName ReferencedPackage)> Visit)
+	{
+		const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		TSet<FName> Visited{PackageName};
+		TArray<FName> Queue{PackageName};
+		TArray<FName> Referencers;
+		TArray<FAssetData> Assets;
+		while (Queue.Num() > 0)
+		{
+			const FName ReferencedPackage = Queue.Pop(false);
+
+			Referencers.Reset();
+			AssetRegistry.GetReferencers(ReferencedPackage, Referencers, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+			for (const FName Referencer : Referencers)
+			{
+				bool bAlreadyVisited = false;
+				Visited.Add(Referencer, &bAlreadyVisited);
+				if (bAlreadyVisited)
+				{
+					continue;
+				}
+
+				Assets.Reset();
+				AssetRegistry.GetAssetsByPackageName(Referencer, Assets, true);
+				for (const FAssetData& AssetData : Assets)
+				{
+					if (Visit(AssetData, ReferencedPackage))
+					{
+						Queue.Add(Referencer);
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	bool IsDirectChildBlueprint(const FAssetData& AssetData, FName ParentPackage)
+	{
+		FString ParentClassPath;
+		if (!AssetData.GetTagValue(FBlueprintTags::ParentClassPath, ParentClassPath))
+		{
+			return false;
+		}
+
+		const FString ParentObjectPath = FPackageName::ExportTextPathToObjectPath(ParentClassPath);
+		return FName{FPackageName::ObjectPathToPackageName(ParentObjectPath)} == ParentPackage;
+	}
+}
+
+FPropertyCommentRenameHandler::FPropertyCommentRenameHandler()
+{
+	FBlueprintEditorUtils::OnRenameVariableReferencesEvent.AddRaw(this, &FPropertyCommentRenameHandler::HandleRenameVariableReferences);
+	FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FPropertyCommentRenameHandler::HandleAssetLoaded);
+	LoadPendingRenames();
+}
+
+FPropertyCommentRenameHandler::~FPropertyCommentRenameHandler()
+{
+	FBlueprintEditorUtils::OnRenameVariableReferencesEvent.RemoveAll(this);
+	FCoreUObjectDelegates::OnAssetLoaded.RemoveAll(this);
+}
+
+void FPropertyCommentRenameHandler::PreChange(const UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo Info)
+{
+	// The descriptions already carry the new names at this point, but the compiled properties do not
+	PreChangeMemberNames.Reset();
+	if (Info != FStructureEditorUtils::RenamedVariable || !Struct)
+	{
+		return;
+	}
+
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		PreChangeMemberNames.Add(FStructureEditorUtils::GetGuidForProperty(*It), It->GetFName());
+	}
+}
+
+void FPropertyCommentRenameHandler::PostChange(const UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo Info)
+{
+	if (Info != FStructureEditorUtils::RenamedVariable || !Struct || PreChangeMemberNames.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FRename, TInlineAllocator<4>> Renames;
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FName* OldName = PreChangeMemberNames.Find(FStructureEditorUtils::GetGuidForProperty(*It));
+		if (OldName && *OldName != It->GetFName())
+		{
+			// Member names are made unique with the member guid, so they cannot clash with other nested names
+			Renames.Add({*OldName, It->GetFName(), EPropertyCommentRenameScope::Nested, {}});
+		}
+	}
+	PreChangeMemberNames.Reset();
+
+	if (Renames.Num() == 0)
+	{
+		return;
+	}
+
+	// Structs embed the members of the structs they contain, so their referencers are affected too
+	const TSet<FName> SidecarBlueprints = PropertyCommentPackageUtils::GetSidecarBlueprints();
+	bool bQueued = false;
+	ForEachReferencer(Struct->GetOutermost()->GetFName(), [this, &Renames, &SidecarBlueprints, &bQueued](const FAssetData& Referencer, FName)
+	{
+		if (Referencer.AssetClass == UUserDefinedStruct::StaticClass()->GetFName())
+		{
+			return true;
+		}
+
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(Referencer.FastGetAsset(false)))
+		{
+			for (const FRename& Rename : Renames)
+			{
+				ApplyRename(Blueprint, Rename);
+			}
+		}
+		else if (!Referencer.IsAssetLoaded() && PropertyCommentPackageUtils::MayHaveComments(Referencer, SidecarBlueprints))
+		{
+			PendingRenames.FindOrAdd(Referencer.PackageName).Append(Renames);
+			bQueued = true;
+		}
+		return false;
+	});
+
+	if (bQueued)
+	{
+		SavePendingRenames();
+	}
+}
+
+void FPropertyCommentRenameHandler::HandleRenameVariableReferences(UBlueprint* Blueprint, UClass* VariableClass, const FName& OldVarName,
+	const FName& NewVarName)
+{
+	if (!IsValid(Blueprint) || !VariableClass || !Blueprint->GeneratedClass)
+	{
+		return;
+	}
+
+	// The blueprint editor raises this for the owning blueprint and every loaded blueprint depending on it
+	UClass* OwnerClass = VariableClass->GetAuthoritativeClass();
+	const FRename Rename{OldVarName, NewVarName, EPropertyCommentRenameScope::TopLevel, OwnerClass};
+	ApplyRename(Blueprint, Rename);
+
+	if (Blueprint->GeneratedClass != OwnerClass)
+	{
+		return;
+	}
+
+	// Unloaded child blueprints are found through their parent class tag, one generation at a time
+	const TSet<FName> SidecarBlueprints = PropertyCommentPackageUtils::GetSidecarBlueprints();
+	bool bQueued = false;
+	ForEachReferencer(Blueprint->GetOutermost()->GetFName(), [this, &Rename, &SidecarBlueprints, &bQueued](const FAssetData& Referencer, FName ReferencedPackage)
+	{
+		if (!IsDirectChildBlueprint(Referencer, ReferencedPackage))
+		{
+			return false;
+		}
+
+		if (!Referencer.IsAssetLoaded() && PropertyCommentPackageUtils::MayHaveComments(Referencer, SidecarBlueprints))
+		{
+			PendingRenames.FindOrAdd(Referencer.PackageName).Add(Rename);
+			bQueued = true;
+		}
+		return true;
+	});
+
+	if (bQueued)
+	{
+		SavePendingRenames();
+	}
+}
+
+void FPropertyCommentRenameHandler::HandleAssetLoaded(UObject* Asset)
+{
+	if (PendingRenames.Num() == 0)
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(Asset);
+	TArray<FRename> Renames;
+	if (Blueprint && PendingRenames.RemoveAndCopyValue(Blueprint->GetOutermost()->GetFName(), Renames))
+	{
+		// Applied in the order they happened, so chained renames end up at the latest name
+		for (const FRename& Rename : Renames)
+		{
+			ApplyRename(Blueprint, Rename);
+		}
+		SavePendingRenames();
+	}
+}
+
+void FPropertyCommentRenameHandler::ApplyRename(UBlueprint* Blueprint, const FRename& Rename)
+{
+	if (!Rename.OwnerClass.IsNull())
+	{
+		const UClass* OwnerClass = Rename.OwnerClass.Get();
+		if (!OwnerClass || !Blueprint->GeneratedClass || !Blueprint->GeneratedClass->IsChildOf(OwnerClass))
+		{
+			return;
+		}
+	}
+
+	UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
+	if (!IsValid(Extension) || Extension->GetNumComments() == 0)
+	{
+		return;
+	}
+
+	// Recorded in the rename transaction of the blueprint editor, so undoing the rename moves the comments back
+	Extension->Modify(false);
+	const int32 NumRenamed = Extension->RenameProperty(Rename.OldName, Rename.NewName, Rename.Scope);
+	if (NumRenamed > 0)
+	{
+		UE_LOG(LogBlueprintPropertyComment, Verbose, TEXT("Moved %d comment(s) of %s from %s to %s"),
+			NumRenamed, *Blueprint->GetPathName(), *Rename.OldName.ToString(), *Rename.NewName.ToString());
+		Extension->MarkCommentsDirty();
+	}
+}
+
+void FPropertyCommentRenameHandler::LoadPendingRenames()
+{
+	const FString Filename = GetPendingRenamesFilename();
+	const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent)};
+	if (!Reader)
+	{
+		return;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumPackages = 0;
+	*Reader << Magic << Version << NumPackages;
+	// Every package takes more than a few bytes, which bounds the count of a damaged header
+	const bool bValidCount = NumPackages >= 0 && NumPackages <= Reader->TotalSize() / 8;
+	if (Reader->IsError() || Magic != PendingRenamesMagic || Version != PendingRenamesVersion || !bValidCount)
+	{
+		return;
+	}
+
+	// Plain file archives do not serialize names, they go through strings like the owner class path
+	for (int32 PackageIndex = 0; PackageIndex < NumPackages && !Reader->IsError(); ++PackageIndex)
+	{
+		FString PackageName;
+		int32 NumRenames = 0;
+		*Reader << PackageName << NumRenames;
+		if (NumRenames < 0 || NumRenames > Reader->TotalSize() / 8)
+		{
+			Reader->SetError();
+			break;
+		}
+
+		TArray<FRename>& Renames = PendingRenames.FindOrAdd(FName{PackageName});
+		for (int32 RenameIndex = 0; RenameIndex < NumRenames && !Reader->IsError(); ++RenameIndex)
+		{
+			FString OldName;
+			FString NewName;
+			uint8 Scope = 0;
+			FString OwnerClass;
+			*Reader << OldName << NewName << Scope << OwnerClass;
+			Renames.Add({FName{OldName}, FName{NewName}, static_cast<EPropertyCommentRenameScope>(Scope), TSoftClassPtr<UObject>{FSoftObjectPath{OwnerClass}}});
+		}
+	}
+
+	if (Reader->IsError())
+	{
+		UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Discarding the damaged pending comment renames %s"), *Filename);
+		PendingRenames.Reset();
+		return;
+	}
+
+	// Blueprints deleted since are dropped, blueprints loaded before the handler existed get their renames now
+	const int32 NumRead = PendingRenames.Num();
+	for (auto It = PendingRenames.CreateIterator(); It; ++It)
+	{
+		if (!FPackageName::DoesPackageExist(It.Key().ToString()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<UBlueprint*> LoadedBlueprints;
+	for (const TPair<FName, TArray<FRename>>& Pair : PendingRenames)
+	{
+		if (const UPackage* Package = FindPackage(nullptr, *Pair.Key.ToString()))
+		{
+			ForEachObjectWithPackage(Package, [&LoadedBlueprints](UObject* Object)
+			{
+				if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+				{
+					LoadedBlueprints.Add(Blueprint);
+				}
+				return true;
+			}, false);
+		}
+	}
+
+	for (UBlueprint* Blueprint : LoadedBlueprints)
+	{
+		HandleAssetLoaded(Blueprint);
+	}
+
+	if (LoadedBlueprints.Num() == 0 && PendingRenames.Num() != NumRead)
+	{
+		SavePendingRenames();
+	}
+}
+
+void FPropertyCommentRenameHandler::SavePendingRenames() const
+{
+	const FString Filename = GetPendingRenamesFilename();
+	if (PendingRenames.Num() == 0)
+	{
+		IFileManager::Get().Delete(*Filename, false, false, true);
+		return;
+	}
+
+	// Written next to the file and moved over it, so a crash never leaves a half written file behind
+	const FString TempFilename = Filename + TEXT(".tmp");
+	{
+		const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*TempFilename)};
+		if (!Writer)
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Could not write the pending comment renames to %s"), *Filename);
+			return;
+		}
+
+		uint32 Magic = PendingRenamesMagic;
+		int32 Version = PendingRenamesVersion;
+		int32 NumPackages = PendingRenames.Num();
+		*Writer << Magic << Version << NumPackages;
+		for (const TPair<FName, TArray<FRename>>& Pair : PendingRenames)
+		{
+			FString PackageName = Pair.Key.ToString();
+			int32 NumRenames = Pair.Value.Num();
+			*Writer << PackageName << NumRenames;
+			for (const FRename& Rename : Pair.Value)
+			{
+				FString OldName = Rename.OldName.ToString();
+				FString NewName = Rename.NewName.ToString();
+				uint8 Scope = static_cast<uint8>(Rename.Scope);
+				FString OwnerClass = Rename.OwnerClass.ToString();
+				*Writer << OldName << NewName << Scope << OwnerClass;
+			}
+		}
+
+		if (!Writer->Close())
+		{
+			IFileManager::Get().Delete(*TempFilename, false, false, true);
+			return;
+		}
+	}
+
+	IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+}
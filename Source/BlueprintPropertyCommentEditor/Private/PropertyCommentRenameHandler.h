@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PropertyCommentExtension.h"
+#include "Kismet2/StructureEditorUtils.h"
+#include "UObject/SoftObjectPtr.h"
+
+class UBlueprint;
+
+/**
+ * Keeps comment keys in sync when the property names they embed are renamed, either as blueprint
+ * member variables or as user defined struct members.
+ *
+ * Only blueprints that can contain the renamed property are touched: the ones the blueprint editor
+ * already visits for a variable rename, and the asset registry referencers of a renamed struct.
+ * Within a blueprint only the path nodes carrying the old name are rewritten. Commented blueprints
+ * that are not loaded get the rename applied when they next load. Those renames are kept in
+ * Saved/PropertyComments, so they survive the editor closing before the blueprints are loaded.
+ *
+ * Reparenting needs no handling, as it does not change the names of the properties that remain.
+ */
+class FPropertyCommentRenameHandler final : public FStructureEditorUtils::FStructEditorManager::ListenerType
+{
+public:
+	FPropertyCommentRenameHandler();
+	virtual ~FPropertyCommentRenameHandler() override;
+
+	//~ Begin FStructEditorManager::ListenerType Interface
+	virtual void PreChange(const UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo Info) override;
+	virtual void PostChange(const UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo Info) override;
+	//~ End FStructEditorManager::ListenerType Interface
+
+private:
+	struct FRename
+	{
+		FName OldName;
+		FName NewName;
+		EPropertyCommentRenameScope Scope;
+
+		/** Class declaring a renamed member variable. Unset for struct members. */
+		TSoftClassPtr<UObject> OwnerClass;
+	};
+
+	void HandleRenameVariableReferences(UBlueprint* Blueprint, UClass* VariableClass, const FName& OldVarName, const FName& NewVarName);
+	void HandleAssetLoaded(UObject* Asset);
+
+	/** Applies the renames to loaded referencers of the package and queues them for the unloaded, commented ones. */
+	void ApplyToReferencers(FName PackageName, TConstArrayView<FRename> Renames, bool bFollowStructs);
+
+	static void ApplyRename(UBlueprint* Blueprint, const FRename& Rename);
+
+	/** Reads the renames left over by earlier sessions and applies those of blueprints loaded since. */
+	void LoadPendingRenames();
+
+	/** Writes the pending renames after they changed, or deletes the file once there are none. */
+	void SavePendingRenames() const;
+
+	/** Property names of the struct being changed, by member guid, captured before it is recompiled. */
+	TMap<FGuid, FName> PreChangeMemberNames;
+
+	/** Renames waiting for unloaded blueprints, by package name. */
+	TMap<FName, TArray<FRename>> PendingRenames;
+};
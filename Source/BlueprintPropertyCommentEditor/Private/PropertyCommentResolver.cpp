@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentResolver.h"
+#include "PropertyCommentPath.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+
+FPropertyCommentResolver::FPropertyCommentResolver(const UBlueprint* Blueprint)
+{
+	check(IsInGameThread());
+
+	if (!IsValid(Blueprint) || !Blueprint->GeneratedClass)
+	{
+		return;
+	}
+
+	Roots.Add(Blueprint->GeneratedClass);
+
+	// Component templates are archetypes, so their rows are keyed relative to the component class
+	if (const USimpleConstructionScript* ConstructionScript = Blueprint->SimpleConstructionScript)
+	{
+		for (const USCS_Node* Node : ConstructionScript->GetAllNodes())
+		{
+			if (Node && Node->ComponentClass)
+			{
+				Roots.AddUnique(Node->ComponentClass);
+			}
+		}
+	}
+
+	TArray<UObject*> DefaultSubobjects;
+	Blueprint->GeneratedClass->GetDefaultObject()->GetDefaultSubobjects(DefaultSubobjects);
+	for (const UObject* Subobject : DefaultSubobjects)
+	{
+		Roots.AddUnique(Subobject->GetClass());
+	}
+}
+
+bool FPropertyCommentResolver::CanResolve(const FPropertyCommentPath& PropertyPath) const
+{
+	for (const UStruct* Root : Roots)
+	{
+		if (PropertyPath.Resolve(Root))
+		{
+			return true;
+		}
+	}
+	return false;
+}
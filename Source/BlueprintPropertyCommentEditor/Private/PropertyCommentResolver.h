@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+struct FPropertyCommentPath;
+
+/**
+ * Checks comment paths against the layout of the objects a blueprint exposes in the details panel:
+ * its generated class and the classes of its component templates.
+ */
+class FPropertyCommentResolver
+{
+public:
+	explicit FPropertyCommentResolver(const UBlueprint* Blueprint);
+
+	/** Only reads the gathered property layouts, so it may be called from worker threads. */
+	bool CanResolve(const FPropertyCommentPath& PropertyPath) const;
+
+private:
+	TArray<const UStruct*, TInlineAllocator<8>> Roots;
+};
@@ -0,0 +1,140 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentRow.h"
+#include "BlueprintResolveCache.h"
+#include "PropertyHandle.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentStats.h"
+#include "Engine/Blueprint.h"
+
+// Starts at 1 so that freshly constructed rows (generation 0) always resolve once
+uint32 FPropertyCommentRow::Generation = 1;
+
+FPropertyCommentRow::FPropertyCommentRow(TSharedPtr<IPropertyHandle> InPropertyHandle, FBlueprintResolveCache& InResolveCache)
+	: PropertyHandle(MoveTemp(InPropertyHandle))
+	, ResolveCache(InResolveCache)
+	, ResolvedGeneration(0)
+	, ResolveSerial(1)
+{
+}
+
+void FPropertyCommentRow::InvalidateAll()
+{
+	++Generation;
+	if (Generation == 0)
+	{
+		Generation = 1;
+	}
+}
+
+FPropertyCommentPath FPropertyCommentRow::GetPropertyPathRecursive(const TSharedPtr<IPropertyHandle>& InHandle)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PropertyComment::BuildPath);
+	SCOPE_CYCLE_COUNTER(STAT_PropertyComment_BuildPath);
+
+	FPropertyCommentPath Path;
+	for (TSharedPtr<IPropertyHandle> Handle = InHandle; Handle && Handle->IsValidHandle(); Handle = Handle->GetParentHandle())
+	{
+		if (const FProperty* Property = Handle->GetProperty())
+		{
+			Path.Segments.Emplace(Property->GetFName(), Handle->GetIndexInArray());
+		}
+	}
+
+	Algo::Reverse(Path.Segments);
+	return Path;
+}
+
+const TSharedPtr<IPropertyHandle>& FPropertyCommentRow::GetPropertyHandle() const
+{
+	return PropertyHandle;
+}
+
+UBlueprint* FPropertyCommentRow::GetBlueprint()
+{
+	ResolveIfStale();
+	return Blueprints.Num() > 0 ? Blueprints[0].Get() : nullptr;
+}
+
+const TArray<TWeakObjectPtr<UBlueprint>>& FPropertyCommentRow::GetBlueprints()
+{
+	ResolveIfStale();
+	return Blueprints;
+}
+
+const FPropertyCommentPath& FPropertyCommentRow::GetPropertyPath()
+{
+	ResolveIfStale();
+	return PropertyPath;
+}
+
+void FPropertyCommentRow::ResolveIfStale()
+{
+	if (!PropertyHandle.IsValid() || !PropertyHandle->IsValidHandle())
+	{
+		if (ResolvedGeneration != 0)
+		{
+			Blueprints.Reset();
+			PropertyPath.Segments.Reset();
+			ResolvedGeneration = 0;
+			++ResolveSerial;
+		}
+		return;
+	}
+
+	// A stale weak pointer means the blueprint has been destroyed since we resolved it
+	const bool bAnyStale = Blueprints.ContainsByPredicate([](const TWeakObjectPtr<UBlueprint>& Blueprint) { return Blueprint.IsStale(); });
+	if (ResolvedGeneration == Generation && !bAnyStale)
+	{
+		return;
+	}
+
+	ResolveCache.GetBlueprintsFromPropertyHandle(PropertyHandle, Blueprints);
+	PropertyPath = Blueprints.Num() > 0 ? GetPropertyPathRecursive(PropertyHandle) : FPropertyCommentPath{};
+	ResolvedGeneration = Generation;
+	++ResolveSerial;
+}
+
+bool FPropertyCommentRow::IsIconStale()
+{
+	return IsStale(IconStamp);
+}
+
+void FPropertyCommentRow::SetIcon(const FSlateIcon& InIcon)
+{
+	CachedIcon = InIcon;
+	UpdateStamp(IconStamp);
+}
+
+const FSlateIcon& FPropertyCommentRow::GetCachedIcon() const
+{
+	return CachedIcon;
+}
+
+bool FPropertyCommentRow::IsTooltipStale()
+{
+	return IsStale(TooltipStamp);
+}
+
+void FPropertyCommentRow::SetTooltip(const FText& InTooltip)
+{
+	CachedTooltip = InTooltip;
+	UpdateStamp(TooltipStamp);
+}
+
+const FText& FPropertyCommentRow::GetCachedTooltip() const
+{
+	return CachedTooltip;
+}
+
+bool FPropertyCommentRow::IsStale(const FDisplayStamp& InStamp)
+{
+	ResolveIfStale();
+	return InStamp.ResolveSerial != ResolveSerial || InStamp.CommentRevision != UPropertyCommentExtension::GetGlobalRevision();
+}
+
+void FPropertyCommentRow::UpdateStamp(FDisplayStamp& OutStamp) const
+{
+	OutStamp.ResolveSerial = ResolveSerial;
+	OutStamp.CommentRevision = UPropertyCommentExtension::GetGlobalRevision();
+}
@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PropertyCommentPath.h"
+#include "Textures/SlateIcon.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class FBlueprintResolveCache;
+class IPropertyHandle;
+class UBlueprint;
+
+/**
+ * State shared by the attributes of a single details panel row.
+ * The owning blueprints and the property path are resolved lazily and cached until the handle
+ * becomes invalid or the global generation is bumped (e.g. on blueprint compile).
+ * A details panel refresh regenerates its rows and therefore creates fresh row states.
+ */
+class FPropertyCommentRow
+{
+public:
+	FPropertyCommentRow(TSharedPtr<IPropertyHandle> InPropertyHandle, FBlueprintResolveCache& InResolveCache);
+
+	/** Forces every row to resolve its blueprint and path again on their next evaluation. */
+	static void InvalidateAll();
+
+	static FPropertyCommentPath GetPropertyPathRecursive(const TSharedPtr<IPropertyHandle>& InHandle);
+
+	const TSharedPtr<IPropertyHandle>& GetPropertyHandle() const;
+	/** First of the edited blueprints, or null. */
+	UBlueprint* GetBlueprint();
+
+	/** Every blueprint the row edits; several when the details panel shows a multi-selection. */
+	const TArray<TWeakObjectPtr<UBlueprint>>& GetBlueprints();
+	const FPropertyCommentPath& GetPropertyPath();
+
+	/**
+	 * True when the cached icon no longer matches the row, either because it resolved again or
+	 * because a comment changed somewhere since it was computed.
+	 */
+	bool IsIconStale();
+	void SetIcon(const FSlateIcon& InIcon);
+	const FSlateIcon& GetCachedIcon() const;
+
+	/**
+	 * Same as IsIconStale, for the tooltip. Kept apart because the tooltip needs the comment texts,
+	 * which should stay unloaded until a row is actually hovered.
+	 */
+	bool IsTooltipStale();
+	void SetTooltip(const FText& InTooltip);
+	const FText& GetCachedTooltip() const;
+
+private:
+	/** Resolve serial and comment revision a cached value was computed at. */
+	struct FDisplayStamp
+	{
+		uint32 ResolveSerial = 0;
+		uint32 CommentRevision = 0;
+	};
+
+	void ResolveIfStale();
+	bool IsStale(const FDisplayStamp& InStamp);
+	void UpdateStamp(FDisplayStamp& OutStamp) const;
+
+	TSharedPtr<IPropertyHandle> PropertyHandle;
+	FBlueprintResolveCache& ResolveCache;
+	TArray<TWeakObjectPtr<UBlueprint>> Blueprints;
+	FPropertyCommentPath PropertyPath;
+	uint32 ResolvedGeneration;
+
+	// Bumped whenever the resolved values change, so the display cache can tell it is out of date
+	uint32 ResolveSerial;
+	FDisplayStamp IconStamp;
+	FDisplayStamp TooltipStamp;
+	FSlateIcon CachedIcon;
+	FText CachedTooltip;
+
+	static uint32 Generation;
+};
@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentSyntheticBlueprint.h"
+#include "EdGraphSchema_K2.h"
+#include "IDetailTreeNode.h"
+#include "PropertyHandle.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/UserDefinedStruct.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/StructureEditorUtils.h"
+
+namespace
+{
+	FEdGraphPinType MakePinType(const UUserDefinedStruct* Struct, bool bArray)
+	{
+		FEdGraphPinType PinType;
+		PinType.PinCategory = Struct ? UEdGraphSchema_K2::PC_Struct : UEdGraphSchema_K2::PC_Int;
+		PinType.PinSubCategoryObject = const_cast<UUserDefinedStruct*>(Struct);
+		PinType.ContainerType = bArray ? EPinContainerType::Array : EPinContainerType::None;
+		return PinType;
+	}
+
+	/** Chain of structs, each one holding the previous one. Returns the outermost, or null for a depth of zero. */
+	UUserDefinedStruct* CreateNestedStruct(int32 Depth)
+	{
+		UUserDefinedStruct* Inner = nullptr;
+		for (int32 Level = 0; Level < Depth; ++Level)
+		{
+			const FName Name = MakeUniqueObjectName(GetTransientPackage(), UUserDefinedStruct::StaticClass(), TEXT("PropertyCommentSyntheticStruct"));
+			UUserDefinedStruct* Struct = FStructureEditorUtils::CreateUserDefinedStruct(GetTransientPackage(), Name, RF_Transient);
+			FStructureEditorUtils::AddVariable(Struct, MakePinType(nullptr, false));
+			if (Inner)
+			{
+				FStructureEditorUtils::AddVariable(Struct, MakePinType(Inner, false));
+			}
+			Inner = Struct;
+		}
+		return Inner;
+	}
+}
+
+UBlueprint* PropertyCommentSyntheticBlueprint::Create(int32 NumProperties, int32 Depth, int32 NumElements)
+{
+	const FName Name = MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("PropertyCommentSynthetic"));
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(UObject::StaticClass(), GetTransientPackage(), Name, BPTYPE_Normal,
+		UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+
+	const UUserDefinedStruct* Struct = CreateNestedStruct(Depth);
+	for (int32 Index = 0; Index < NumProperties; ++Index)
+	{
+		const bool bStruct = Index % 4 < 2;
+		const bool bArray = Index % 4 == 1 || Index % 4 == 2;
+		FBlueprintEditorUtils::AddMemberVariable(Blueprint, *FString::Printf(TEXT("Property%d"), Index), MakePinType(bStruct ? Struct : nullptr, bArray));
+	}
+
+	// The blueprint is only referenced from here, so it must not be collected by the compile
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+	// Arrays are empty by default and would not show any element rows
+	UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
+	for (TFieldIterator<FArrayProperty> It(Blueprint->GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		FScriptArrayHelper ArrayHelper(*It, It->ContainerPtrToValuePtr<void>(DefaultObject));
+		ArrayHelper.AddValues(NumElements);
+	}
+	return Blueprint;
+}
+
+void PropertyCommentSyntheticBlueprint::GatherPropertyHandles(const TArray<TSharedRef<IDetailTreeNode>>& Nodes, TArray<TSharedPtr<IPropertyHandle>>& OutHandles)
+{
+	TArray<TSharedRef<IDetailTreeNode>> Children;
+	for (const TSharedRef<IDetailTreeNode>& Node : Nodes)
+	{
+		TSharedPtr<IPropertyHandle> Handle = Node->CreatePropertyHandle();
+		if (Handle && Handle->IsValidHandle())
+		{
+			OutHandles.Add(MoveTemp(Handle));
+		}
+
+		Children.Reset();
+		Node->GetChildren(Children);
+		GatherPropertyHandles(Children, OutHandles);
+	}
+}
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IDetailTreeNode;
+class IPropertyHandle;
+class UBlueprint;
+
+/**
+ * Transient blueprints with a known property layout, shared by the benchmark commandlet and the
+ * automation tests so both look at the same details panel rows.
+ */
+namespace PropertyCommentSyntheticBlueprint
+{
+	/**
+	 * Compiled blueprint with member variables named Property0, Property1 and so on. Repeating in
+	 * groups of four they are a struct, an array of that struct, an array of integers and an integer.
+	 * The struct nests Depth levels deep, and every array of the class default object holds
+	 * NumElements elements. Only the transient package references it, so keep it alive while in use.
+	 */
+	UBlueprint* Create(int32 NumProperties, int32 Depth, int32 NumElements);
+
+	/** Every valid property handle below the given nodes, parents before their children. */
+	void GatherPropertyHandles(const TArray<TSharedRef<IDetailTreeNode>>& Nodes, TArray<TSharedPtr<IPropertyHandle>>& OutHandles);
+}
@@ -0,0 +1,260 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PropertyCommentTransfer.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentPackageUtils.h"
+#include "PropertyCommentTextEscape.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	const TCHAR* FileHeader = TEXT("# PropertyComments v1");
+
+	void WriteLine(FArchive& Writer, const FString& Line)
+	{
+		const FTCHARToUTF8 Utf8{*Line};
+		Writer.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+		Writer.Serialize(const_cast<ANSICHAR*>("\n"), 1);
+	}
+
+	/** Reads UTF-8 lines through a fixed-size buffer, so the file never has to fit in memory. */
+	class FLineReader
+	{
+	public:
+		explicit FLineReader(FArchive& InReader)
+			: Reader(InReader)
+		{
+			Buffer.SetNumUninitialized(BufferSize);
+		}
+
+		bool ReadLine(FString& OutLine)
+		{
+			TArray<ANSICHAR> Utf8Line;
+			for (;;)
+			{
+				if (BufferPos == BufferEnd && !Refill())
+				{
+					if (Utf8Line.Num() == 0)
+					{
+						return false;
+					}
+					break;
+				}
+
+				const ANSICHAR Char = Buffer[BufferPos++];
+				if (Char == '\n')
+				{
+					break;
+				}
+				Utf8Line.Add(Char);
+			}
+
+			if (Utf8Line.Num() > 0 && Utf8Line.Last() == '\r')
+			{
+				Utf8Line.Pop(false);
+			}
+
+			const FUTF8ToTCHAR Converted{Utf8Line.GetData(), Utf8Line.Num()};
+			OutLine = FString{Converted.Length(), Converted.Get()};
+			return true;
+		}
+
+	private:
+		bool Refill()
+		{
+			const int64 Remaining = Reader.TotalSize() - Reader.Tell();
+			if (Remaining <= 0)
+			{
+				return false;
+			}
+
+			BufferEnd = static_cast<int32>(FMath::Min<int64>(Remaining, BufferSize));
+			Reader.Serialize(Buffer.GetData(), BufferEnd);
+			BufferPos = 0;
+			return true;
+		}
+
+		static constexpr int32 BufferSize = 64 * 1024;
+
+		FArchive& Reader;
+		TArray<ANSICHAR> Buffer;
+		int32 BufferPos = 0;
+		int32 BufferEnd = 0;
+	};
+
+	struct FImportRecord
+	{
+		FPropertyCommentPath PropertyPath;
+		FString Comment;
+	};
+
+	bool ApplyImportRecords(const FString& BlueprintPath, TArray<FImportRecord>& Records, const FPropertyCommentTransferOptions& Options)
+	{
+		UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+		if (!IsValid(Blueprint))
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Skipping %d comments, could not load blueprint %s"), Records.Num(), *BlueprintPath);
+			return false;
+		}
+
+		UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetOrCreatePropertyCommentExtension(Blueprint);
+		for (FImportRecord& Record : Records)
+		{
+			if (Record.Comment.IsEmpty())
+			{
+				Extension->RemoveComment(Record.PropertyPath);
+			}
+			else
+			{
+				Extension->AddComment(Record.PropertyPath, FText::FromString(MoveTemp(Record.Comment)));
+			}
+		}
+
+		// Sidecar files are written right away, the blueprint package stays untouched
+		const bool bMarkedDirty = Extension->MarkCommentsDirty();
+		if (Extension->IsStoredInSidecar())
+		{
+			return bMarkedDirty;
+		}
+		return !Options.bSavePackages || PropertyCommentPackageUtils::SavePackage(Blueprint->GetOutermost());
+	}
+
+	void CollectGarbageIfNeeded(int32& NumLoadedPackages, const FPropertyCommentTransferOptions& Options)
+	{
+		if (++NumLoadedPackages >= FMath::Max(1, Options.PackagesPerGarbageCollection))
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			NumLoadedPackages = 0;
+		}
+	}
+}
+
+bool FPropertyCommentTransfer::Export(const FString& Filename, const FPropertyCommentTransferOptions& Options, FPropertyCommentTransferStats& OutStats)
+{
+	check(IsInGameThread());
+
+	const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*Filename)};
+	if (!Writer)
+	{
+		UE_LOG(LogBlueprintPropertyComment, Error, TEXT("Could not open %s for writing"), *Filename);
+		return false;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (IsRunningCommandlet())
+	{
+		AssetRegistry.SearchAllAssets(true);
+	}
+
+	TArray<FAssetData> Assets;
+	PropertyCommentPackageUtils::GetCommentedBlueprints(AssetRegistry, Options.bAllBlueprints, Options.PackagePaths, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+
+	WriteLine(*Writer, FileHeader);
+
+	int32 NumLoadedPackages = 0;
+	for (const FAssetData& AssetData : Assets)
+	{
+		const bool bWasLoaded = AssetData.IsAssetLoaded();
+		const UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
+		const UPropertyCommentExtension* Extension = IsValid(Blueprint) ? UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint) : nullptr;
+		if (IsValid(Extension) && Extension->GetNumComments() > 0)
+		{
+			const FString BlueprintPath = Blueprint->GetPathName();
+			Extension->ForEachComment([&Writer, &BlueprintPath, &OutStats](const FPropertyCommentPath& PropertyPath, const FText& Comment)
+			{
+				WriteLine(*Writer, FString::Printf(TEXT("%s\t%s\t%s"), *BlueprintPath, *PropertyPath.ToString(), *PropertyCommentTextEscape::Escape(Comment.ToString())));
+				++OutStats.NumComments;
+			});
+			++OutStats.NumBlueprints;
+		}
+
+		if (!bWasLoaded)
+		{
+			CollectGarbageIfNeeded(NumLoadedPackages, Options);
+		}
+	}
+
+	return Writer->Close();
+}
+
+bool FPropertyCommentTransfer::Import(const FString& Filename, const FPropertyCommentTransferOptions& Options, FPropertyCommentTransferStats& OutStats)
+{
+	check(IsInGameThread());
+
+	const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*Filename)};
+	if (!Reader)
+	{
+		UE_LOG(LogBlueprintPropertyComment, Error, TEXT("Could not open %s for reading"), *Filename);
+		return false;
+	}
+
+	FString CurrentBlueprint;
+	TArray<FImportRecord> CurrentRecords;
+	int32 NumLoadedPackages = 0;
+
+	const auto Flush = [&]()
+	{
+		if (CurrentRecords.Num() == 0)
+		{
+			return;
+		}
+
+		if (ApplyImportRecords(CurrentBlueprint, CurrentRecords, Options))
+		{
+			++OutStats.NumBlueprints;
+			OutStats.NumComments += CurrentRecords.Num();
+		}
+		else
+		{
+			++OutStats.NumFailedBlueprints;
+		}
+
+		CurrentRecords.Reset();
+		CollectGarbageIfNeeded(NumLoadedPackages, Options);
+	};
+
+	FLineReader LineReader{*Reader};
+	FString Line;
+	int32 LineNumber = 0;
+	while (LineReader.ReadLine(Line))
+	{
+		++LineNumber;
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		FStringView Remaining = Line;
+		int32 FirstTab = INDEX_NONE;
+		int32 SecondTab = INDEX_NONE;
+		if (!Remaining.FindChar(TEXT('\t'), FirstTab) || !Remaining.RightChop(FirstTab + 1).FindChar(TEXT('\t'), SecondTab))
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("%s(%d): malformed record"), *Filename, LineNumber);
+			continue;
+		}
+		SecondTab += FirstTab + 1;
+
+		const FStringView BlueprintPath = Remaining.Left(FirstTab);
+		if (!BlueprintPath.Equals(CurrentBlueprint, ESearchCase::CaseSensitive))
+		{
+			Flush();
+			CurrentBlueprint = FString{BlueprintPath};
+		}
+
+		FImportRecord& Record = CurrentRecords.AddDefaulted_GetRef();
+		Record.PropertyPath = FPropertyCommentPath::FromString(Remaining.Mid(FirstTab + 1, SecondTab - FirstTab - 1));
+		Record.Comment = PropertyCommentTextEscape::Unescape(Remaining.RightChop(SecondTab + 1));
+		if (Record.PropertyPath.IsEmpty())
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("%s(%d): empty property path"), *Filename, LineNumber);
+			CurrentRecords.Pop(false);
+		}
+	}
+	Flush();
+
+	return true;
+}
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Search/PropertyCommentIndexCache.h"
+#include "BlueprintPropertyComment.h"
+#include "HAL/FileManager.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr uint32 CacheFileMagic = 0x50434958; // "PCIX"
+
+	// Bump when the layout below changes, older files are then dropped and rebuilt
+	constexpr int32 CacheFileVersion = 1;
+
+	void SerializeEntry(FArchive& Ar, FName& PackageName, PropertyCommentIndexCache::FPackageEntry& Entry)
+	{
+		// Plain file archives do not serialize names, they go through strings like the blueprint path
+		FString PackageString = PackageName.ToString();
+		Ar << PackageString;
+		Ar << Entry.SavedHash;
+		if (Ar.IsLoading())
+		{
+			PackageName = FName{PackageString};
+		}
+
+		FString BlueprintPath = Entry.Blueprint.ToString();
+		Ar << BlueprintPath;
+		if (Ar.IsLoading())
+		{
+			Entry.Blueprint = FSoftObjectPath{BlueprintPath};
+		}
+
+		Ar << Entry.PropertyPaths;
+		Ar << Entry.Comments;
+	}
+}
+
+namespace PropertyCommentIndexCache
+{
+	FString GetDefaultFilename()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("PropertyComments") / TEXT("SearchIndex.bin");
+	}
+
+	TMap<FName, FPackageEntry> LoadFile(const FString& Filename)
+	{
+		TMap<FName, FPackageEntry> Entries;
+
+		const TUniquePtr<FArchive> Reader{IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent)};
+		if (!Reader)
+		{
+			return Entries;
+		}
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		int32 NumEntries = 0;
+		*Reader << Magic << Version << NumEntries;
+		// Every entry takes more than a few bytes, which bounds the count of a damaged header
+		const bool bValidCount = NumEntries >= 0 && NumEntries <= Reader->TotalSize() / 8;
+		if (Reader->IsError() || Magic != CacheFileMagic || Version != CacheFileVersion || !bValidCount)
+		{
+			return Entries;
+		}
+
+		Entries.Reserve(NumEntries);
+		for (int32 Index = 0; Index < NumEntries && !Reader->IsError(); ++Index)
+		{
+			FName PackageName;
+			FPackageEntry Entry;
+			SerializeEntry(*Reader, PackageName, Entry);
+			if (Entry.PropertyPaths.Num() == Entry.Comments.Num())
+			{
+				Entries.Add(PackageName, MoveTemp(Entry));
+			}
+		}
+
+		if (Reader->IsError())
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Discarding the damaged comment index cache %s"), *Filename);
+			Entries.Reset();
+		}
+		return Entries;
+	}
+
+	bool SaveFile(const FString& Filename, const TMap<FName, FPackageEntry>& Entries)
+	{
+		// Scans finishing close together may save from two tasks at once
+		static FCriticalSection SaveCritical;
+		FScopeLock SaveLock(&SaveCritical);
+
+		const FString TempFilename = Filename + TEXT(".tmp");
+		{
+			const TUniquePtr<FArchive> Writer{IFileManager::Get().CreateFileWriter(*TempFilename)};
+			if (!Writer)
+			{
+				return false;
+			}
+
+			uint32 Magic = CacheFileMagic;
+			int32 Version = CacheFileVersion;
+			int32 NumEntries = Entries.Num();
+			*Writer << Magic << Version << NumEntries;
+			for (const TPair<FName, FPackageEntry>& Pair : Entries)
+			{
+				// Saving archives only read from the entry
+				FName PackageName = Pair.Key;
+				SerializeEntry(*Writer, PackageName, const_cast<FPackageEntry&>(Pair.Value));
+			}
+
+			if (!Writer->Close())
+			{
+				IFileManager::Get().Delete(*TempFilename, false, false, true);
+				return false;
+			}
+		}
+
+		return IFileManager::Get().Move(*Filename, *TempFilename, true, true);
+	}
+}
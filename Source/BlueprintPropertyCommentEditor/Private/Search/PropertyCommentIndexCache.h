@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Comments extracted by the project search, kept on disk between editor sessions. Each package is
+ * stored with the saved hash it had when its comments were extracted, so a later scan only has to
+ * load the packages saved since. Files are streamed in and out, and may be read on worker threads.
+ */
+namespace PropertyCommentIndexCache
+{
+	struct FPackageEntry
+	{
+		FString SavedHash;
+		FSoftObjectPath Blueprint;
+		TArray<FString> PropertyPaths;
+
+		/** Same order as PropertyPaths. */
+		TArray<FString> Comments;
+	};
+
+	FString GetDefaultFilename();
+
+	/** Missing, outdated or damaged files yield an empty map. */
+	TMap<FName, FPackageEntry> LoadFile(const FString& Filename);
+
+	/** Writes to a temporary file first, so a crash never leaves a half written cache behind. */
+	bool SaveFile(const FString& Filename, const TMap<FName, FPackageEntry>& Entries);
+}
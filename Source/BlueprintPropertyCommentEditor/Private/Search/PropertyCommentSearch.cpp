@@ -0,0 +1,537 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Search/PropertyCommentSearch.h"
+#include "BlueprintPropertyComment.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentPackageHash.h"
+#include "PropertyCommentPackageUtils.h"
+#include "PropertyCommentSettings.h"
+#include "PropertyCommentTokenizer.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "Search/PropertyCommentIndexCache.h"
+#include "Tasks/Task.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	// Loading is the expensive part of a scan, so only a handful of packages are requested at a time
+	constexpr int32 MaxInFlightLoads = 8;
+
+	// Records are indexed in batches so that each worker task has a meaningful amount of work
+	constexpr int32 RecordsPerShard = 1024;
+}
+
+struct FPropertyCommentSearch::FShard
+{
+	TArray<FPropertyCommentSearchRecord> Records;
+
+	/** Token -> sorted indices into Records. */
+	TMap<FString, TArray<int32>> Postings;
+
+	/** Sorted keys of Postings, used for prefix matching the last query token. */
+	TArray<FString> Vocabulary;
+};
+
+void FPropertyCommentSearch::StartScan()
+{
+	check(IsInGameThread());
+
+	Cancel();
+	Shards.Reset();
+	NumIndexedComments = 0;
+	QueryResetDelegate.ExecuteIfBound();
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// Only blueprints that advertise comments through their tags need to be indexed
+	TArray<FAssetData> Packages;
+	PropertyCommentPackageUtils::GetCommentedBlueprints(AssetRegistry, false, {}, Packages);
+
+	// Saved packages may be served by the index cache. Unsaved changes only exist in memory. Comments kept
+	// in sidecar files change without touching the package, so its hash cannot tell whether they are current.
+	const bool bUseIndexCache = GetDefault<UPropertyCommentSettings>()->Storage != EPropertyCommentStorage::Sidecar;
+	TArray<FString> SavedHashes;
+	for (FAssetData& AssetData : Packages)
+	{
+		const UPackage* LoadedPackage = AssetData.IsAssetLoaded() ? FindPackage(nullptr, *AssetData.PackageName.ToString()) : nullptr;
+		FString SavedHash = bUseIndexCache ? PropertyCommentPackageHash::Get(AssetRegistry, AssetData.PackageName) : FString();
+		if (!SavedHash.IsEmpty() && !(LoadedPackage && LoadedPackage->IsDirty()))
+		{
+			CacheableHashes.Add(AssetData.PackageName, SavedHash);
+			SavedHashes.Add(MoveTemp(SavedHash));
+			PackagesToCheck.Add(MoveTemp(AssetData));
+		}
+		else if (LoadedPackage)
+		{
+			ExtractComments(AssetData);
+		}
+		else
+		{
+			PackagesToLoad.Add(MoveTemp(AssetData));
+		}
+	}
+
+	if (PackagesToCheck.Num() > 0)
+	{
+		LoadIndexCache(SavedHashes);
+	}
+	PumpPackageLoads();
+}
+
+void FPropertyCommentSearch::Cancel()
+{
+	check(IsInGameThread());
+
+	// Bumping the ids makes every callback and task still in flight discard its output
+	++ScanId;
+	++QueryId;
+	PackagesToCheck.Reset();
+	bLoadingIndexCache = false;
+	CacheableHashes.Reset();
+	IndexedPackages.Reset();
+	bIndexCacheOutdated = false;
+	PackagesToLoad.Reset();
+	PendingSnapshots.Reset();
+	NumPendingRecords = 0;
+	NumInFlightLoads = 0;
+	NumShardsBuilding = 0;
+}
+
+void FPropertyCommentSearch::SetQuery(const FString& InQuery)
+{
+	check(IsInGameThread());
+
+	Query = InQuery;
+	++QueryId;
+	QueryResetDelegate.ExecuteIfBound();
+
+	for (const FShardRef& Shard : Shards)
+	{
+		LaunchQuery(Shard);
+	}
+}
+
+FOnPropertyCommentSearchResults& FPropertyCommentSearch::OnResults()
+{
+	return ResultsDelegate;
+}
+
+FSimpleDelegate& FPropertyCommentSearch::OnQueryReset()
+{
+	return QueryResetDelegate;
+}
+
+bool FPropertyCommentSearch::IsScanning() const
+{
+	return bLoadingIndexCache || PackagesToLoad.Num() > 0 || NumInFlightLoads > 0 || NumShardsBuilding > 0 || PendingSnapshots.Num() > 0;
+}
+
+int32 FPropertyCommentSearch::GetNumPendingPackages() const
+{
+	return PackagesToCheck.Num() + PackagesToLoad.Num() + NumInFlightLoads;
+}
+
+int32 FPropertyCommentSearch::GetNumIndexedComments() const
+{
+	return NumIndexedComments;
+}
+
+void FPropertyCommentSearch::LoadIndexCache(const TArray<FString>& SavedHashes)
+{
+	bLoadingIndexCache = true;
+
+	TArray<FName> PackageNames;
+	PackageNames.Reserve(PackagesToCheck.Num());
+	for (const FAssetData& AssetData : PackagesToCheck)
+	{
+		PackageNames.Add(AssetData.PackageName);
+	}
+
+	TWeakPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> WeakThis = AsShared();
+	const uint32 RequestScanId = ScanId;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, RequestScanId, PackageNames = MoveTemp(PackageNames), SavedHashes]()
+	{
+		TMap<FName, PropertyCommentIndexCache::FPackageEntry> Entries = PropertyCommentIndexCache::LoadFile(PropertyCommentIndexCache::GetDefaultFilename());
+
+		// Cached records are grouped the same way as extracted ones, then indexed in parallel
+		TArray<int32> StalePackages;
+		TArray<FName> CachedPackages;
+		TArray<TArray<FPropertyCommentSearchRecord>> Batches;
+		for (int32 Index = 0; Index < PackageNames.Num(); ++Index)
+		{
+			PropertyCommentIndexCache::FPackageEntry* Entry = Entries.Find(PackageNames[Index]);
+			if (!Entry || Entry->SavedHash != SavedHashes[Index])
+			{
+				StalePackages.Add(Index);
+				continue;
+			}
+
+			CachedPackages.Add(PackageNames[Index]);
+			if (Batches.Num() == 0 || Batches.Last().Num() >= RecordsPerShard)
+			{
+				Batches.AddDefaulted();
+			}
+			for (int32 RecordIndex = 0; RecordIndex < Entry->Comments.Num(); ++RecordIndex)
+			{
+				Batches.Last().Add({Entry->Blueprint, MoveTemp(Entry->PropertyPaths[RecordIndex]), MoveTemp(Entry->Comments[RecordIndex])});
+			}
+		}
+
+		// Entries of packages that lost their comments or were deleted have to leave the file
+		const bool bCacheOutdated = StalePackages.Num() > 0 || CachedPackages.Num() != Entries.Num();
+
+		TArray<TSharedPtr<const FShard, ESPMode::ThreadSafe>> BuiltShards;
+		BuiltShards.SetNum(Batches.Num());
+		ParallelFor(Batches.Num(), [&Batches, &BuiltShards](int32 Index)
+		{
+			BuiltShards[Index] = BuildShardFromRecords(MoveTemp(Batches[Index]));
+		});
+
+		TArray<FShardRef> CachedShards;
+		CachedShards.Reserve(BuiltShards.Num());
+		for (const TSharedPtr<const FShard, ESPMode::ThreadSafe>& Shard : BuiltShards)
+		{
+			CachedShards.Add(Shard.ToSharedRef());
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestScanId, StalePackages = MoveTemp(StalePackages), CachedPackages = MoveTemp(CachedPackages),
+			CachedShards = MoveTemp(CachedShards), bCacheOutdated]()
+		{
+			const TSharedPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (This && This->ScanId == RequestScanId)
+			{
+				This->HandleIndexCacheLoaded(StalePackages, CachedPackages, CachedShards, bCacheOutdated);
+			}
+		});
+	});
+}
+
+void FPropertyCommentSearch::HandleIndexCacheLoaded(const TArray<int32>& StalePackages, const TArray<FName>& CachedPackages,
+	const TArray<FShardRef>& CachedShards, bool bCacheOutdated)
+{
+	bLoadingIndexCache = false;
+	bIndexCacheOutdated |= bCacheOutdated;
+	IndexedPackages.Append(CachedPackages);
+
+	UE_LOG(LogBlueprintPropertyComment, Log, TEXT("Comment index cache covered %d of %d blueprints"), CachedPackages.Num(), PackagesToCheck.Num());
+
+	for (const int32 Index : StalePackages)
+	{
+		FAssetData& AssetData = PackagesToCheck[Index];
+		if (AssetData.IsAssetLoaded())
+		{
+			ExtractComments(AssetData);
+		}
+		else
+		{
+			PackagesToLoad.Add(MoveTemp(AssetData));
+		}
+	}
+	PackagesToCheck.Reset();
+
+	for (const FShardRef& Shard : CachedShards)
+	{
+		AddShard(Shard);
+	}
+
+	PumpPackageLoads();
+}
+
+void FPropertyCommentSearch::SaveIndexCacheIfComplete()
+{
+	if (IsScanning() || !bIndexCacheOutdated)
+	{
+		return;
+	}
+	bIndexCacheOutdated = false;
+
+	TMap<FName, FString> SavedHashes;
+	SavedHashes.Reserve(IndexedPackages.Num());
+	for (const FName PackageName : IndexedPackages)
+	{
+		SavedHashes.Add(PackageName, CacheableHashes.FindChecked(PackageName));
+	}
+
+	// Shards are immutable, so the task can read them while new scans replace them
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [SavedHashes = MoveTemp(SavedHashes), ShardsToSave = Shards]()
+	{
+		TMap<FName, PropertyCommentIndexCache::FPackageEntry> Entries;
+		Entries.Reserve(SavedHashes.Num());
+		for (const TPair<FName, FString>& Pair : SavedHashes)
+		{
+			Entries.Add(Pair.Key).SavedHash = Pair.Value;
+		}
+
+		for (const FShardRef& Shard : ShardsToSave)
+		{
+			for (const FPropertyCommentSearchRecord& Record : Shard->Records)
+			{
+				if (PropertyCommentIndexCache::FPackageEntry* Entry = Entries.Find(FName{Record.Blueprint.GetLongPackageName()}))
+				{
+					Entry->Blueprint = Record.Blueprint;
+					Entry->PropertyPaths.Add(Record.PropertyPath);
+					Entry->Comments.Add(Record.Comment);
+				}
+			}
+		}
+
+		const FString Filename = PropertyCommentIndexCache::GetDefaultFilename();
+		if (!PropertyCommentIndexCache::SaveFile(Filename, Entries))
+		{
+			UE_LOG(LogBlueprintPropertyComment, Warning, TEXT("Could not write the comment index cache %s"), *Filename);
+		}
+	});
+}
+
+void FPropertyCommentSearch::PumpPackageLoads()
+{
+	while (NumInFlightLoads < MaxInFlightLoads && PackagesToLoad.Num() > 0)
+	{
+		FAssetData AssetData = PackagesToLoad.Pop(false);
+		++NumInFlightLoads;
+
+		TWeakPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> WeakThis = AsShared();
+		const uint32 RequestScanId = ScanId;
+		LoadPackageAsync(AssetData.PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda(
+			[WeakThis, RequestScanId, AssetData](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+			{
+				const TSharedPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> This = WeakThis.Pin();
+				if (This && This->ScanId == RequestScanId)
+				{
+					This->HandlePackageLoaded(PackageName, Package, Result, AssetData);
+				}
+			}));
+	}
+
+	FlushPendingRecords(NumInFlightLoads == 0 && PackagesToLoad.Num() == 0);
+	SaveIndexCacheIfComplete();
+}
+
+void FPropertyCommentSearch::HandlePackageLoaded(const FName& PackageName, UPackage* Package, int32 Result, FAssetData AssetData)
+{
+	--NumInFlightLoads;
+
+	if (Result == EAsyncLoadingResult::Succeeded && Package)
+	{
+		ExtractComments(AssetData);
+	}
+
+	PumpPackageLoads();
+}
+
+void FPropertyCommentSearch::ExtractComments(const FAssetData& AssetData)
+{
+	const UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false));
+	if (!IsValid(Blueprint))
+	{
+		return;
+	}
+
+	if (CacheableHashes.Contains(AssetData.PackageName))
+	{
+		IndexedPackages.Add(AssetData.PackageName);
+		bIndexCacheOutdated = true;
+	}
+
+	const UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetPropertyCommentExtension(Blueprint);
+	if (!IsValid(Extension))
+	{
+		return;
+	}
+
+	FPropertyCommentSnapshotRef Snapshot = Extension->GetSnapshot();
+	NumPendingRecords += Snapshot->GetNumComments();
+	PendingSnapshots.Add(MoveTemp(Snapshot));
+
+	FlushPendingRecords(false);
+}
+
+void FPropertyCommentSearch::FlushPendingRecords(bool bForce)
+{
+	if (PendingSnapshots.Num() == 0 || (!bForce && NumPendingRecords < RecordsPerShard))
+	{
+		return;
+	}
+
+	++NumShardsBuilding;
+
+	TWeakPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> WeakThis = AsShared();
+	const uint32 RequestScanId = ScanId;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, RequestScanId, Snapshots = MoveTemp(PendingSnapshots)]()
+	{
+		FShardRef Shard = BuildShard(Snapshots);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestScanId, Shard = MoveTemp(Shard)]()
+		{
+			const TSharedPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (This && This->ScanId == RequestScanId)
+			{
+				--This->NumShardsBuilding;
+				This->AddShard(Shard);
+			}
+		});
+	});
+
+	PendingSnapshots.Reset();
+	NumPendingRecords = 0;
+}
+
+void FPropertyCommentSearch::AddShard(FShardRef Shard)
+{
+	NumIndexedComments += Shard->Records.Num();
+	Shards.Add(Shard);
+	LaunchQuery(Shard);
+	SaveIndexCacheIfComplete();
+}
+
+void FPropertyCommentSearch::LaunchQuery(const FShardRef& Shard)
+{
+	if (Query.IsEmpty())
+	{
+		return;
+	}
+
+	TWeakPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> WeakThis = AsShared();
+	const uint32 RequestQueryId = QueryId;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, RequestQueryId, Shard, QueryCopy = Query]()
+	{
+		TArray<FString> Tokens;
+		PropertyCommentTokenizer::Tokenize(QueryCopy, Tokens);
+
+		TArray<FPropertyCommentSearchResult> Results;
+		QueryShard(Shard, Tokens, Results);
+		if (Results.Num() == 0)
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestQueryId, Results = MoveTemp(Results)]()
+		{
+			const TSharedPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			if (This && This->QueryId == RequestQueryId)
+			{
+				This->ResultsDelegate.ExecuteIfBound(Results);
+			}
+		});
+	});
+}
+
+FPropertyCommentSearch::FShardRef FPropertyCommentSearch::BuildShard(const TArray<FPropertyCommentSnapshotRef>& Snapshots)
+{
+	TArray<FPropertyCommentSearchRecord> Records;
+	for (const FPropertyCommentSnapshotRef& Snapshot : Snapshots)
+	{
+		Snapshot->ForEachComment([&Records, &Snapshot](const FPropertyCommentPath& PropertyPath, const FString& Comment)
+		{
+			Records.Add({Snapshot->GetBlueprint(), PropertyPath.ToString(), Comment});
+		});
+	}
+	return BuildShardFromRecords(MoveTemp(Records));
+}
+
+FPropertyCommentSearch::FShardRef FPropertyCommentSearch::BuildShardFromRecords(TArray<FPropertyCommentSearchRecord>&& Records)
+{
+	TSharedRef<FShard, ESPMode::ThreadSafe> Shard = MakeShared<FShard, ESPMode::ThreadSafe>();
+	Shard->Records = MoveTemp(Records);
+
+	TArray<FString, TInlineAllocator<64>> Tokens;
+	for (int32 RecordIndex = 0; RecordIndex < Shard->Records.Num(); ++RecordIndex)
+	{
+		Tokens.Reset();
+		PropertyCommentTokenizer::Tokenize(Shard->Records[RecordIndex].Comment, Tokens);
+		for (FString& Token : Tokens)
+		{
+			// Records are visited in order, so posting lists stay sorted and only need a tail check
+			TArray<int32>& Posting = Shard->Postings.FindOrAdd(MoveTemp(Token));
+			if (Posting.Num() == 0 || Posting.Last() != RecordIndex)
+			{
+				Posting.Add(RecordIndex);
+			}
+		}
+	}
+
+	Shard->Postings.GetKeys(Shard->Vocabulary);
+	Shard->Vocabulary.Sort();
+	return Shard;
+}
+
+void FPropertyCommentSearch::QueryShard(const FShardRef& Shard, const TArray<FString>& Tokens, TArray<FPropertyCommentSearchResult>& OutResults)
+{
+	if (Tokens.Num() == 0)
+	{
+		return;
+	}
+
+	// Every token but the last must match exactly. The last one is still being typed, so it matches as a prefix.
+	TArray<int32> Matches;
+	bool bFirst = true;
+	const auto Intersect = [&Matches, &bFirst](const TArray<int32>& Posting)
+	{
+		if (bFirst)
+		{
+			Matches = Posting;
+			bFirst = false;
+			return;
+		}
+
+		TArray<int32> Intersection;
+		int32 A = 0;
+		int32 B = 0;
+		while (A < Matches.Num() && B < Posting.Num())
+		{
+			if (Matches[A] < Posting[B])
+			{
+				++A;
+			}
+			else if (Matches[A] > Posting[B])
+			{
+				++B;
+			}
+			else
+			{
+				Intersection.Add(Matches[A]);
+				++A;
+				++B;
+			}
+		}
+		Matches = MoveTemp(Intersection);
+	};
+
+	for (int32 TokenIndex = 0; TokenIndex < Tokens.Num() - 1; ++TokenIndex)
+	{
+		const TArray<int32>* Posting = Shard->Postings.Find(Tokens[TokenIndex]);
+		if (!Posting)
+		{
+			return;
+		}
+		Intersect(*Posting);
+	}
+
+	const FString& Prefix = Tokens.Last();
+	TArray<int32> PrefixMatches;
+	for (int32 Index = Algo::LowerBound(Shard->Vocabulary, Prefix); Index < Shard->Vocabulary.Num(); ++Index)
+	{
+		const FString& Term = Shard->Vocabulary[Index];
+		if (!Term.StartsWith(Prefix, ESearchCase::CaseSensitive))
+		{
+			break;
+		}
+		PrefixMatches.Append(Shard->Postings.FindChecked(Term));
+	}
+
+	PrefixMatches.Sort();
+	PrefixMatches.SetNum(Algo::Unique(PrefixMatches));
+	Intersect(PrefixMatches);
+
+	OutResults.Reserve(OutResults.Num() + Matches.Num());
+	for (const int32 RecordIndex : Matches)
+	{
+		// Results alias the shard, which keeps the records alive for as long as the UI shows them
+		OutResults.Emplace(Shard, &Shard->Records[RecordIndex]);
+	}
+}
@@ -0,0 +1,97 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "PropertyCommentSnapshot.h"
+#include "UObject/SoftObjectPath.h"
+
+class UPackage;
+
+struct FPropertyCommentSearchRecord
+{
+	FSoftObjectPath Blueprint;
+	FString PropertyPath;
+	FString Comment;
+};
+
+using FPropertyCommentSearchResult = TSharedPtr<const FPropertyCommentSearchRecord, ESPMode::ThreadSafe>;
+
+DECLARE_DELEGATE_OneParam(FOnPropertyCommentSearchResults, const TArray<FPropertyCommentSearchResult>& /*Results*/);
+
+/**
+ * Project-wide full-text search over property comments.
+ *
+ * Blueprints are found through the comment asset registry tags. The comments of blueprints whose
+ * saved hash matches the on-disk index cache are read back from it on a worker task; the others are
+ * loaded asynchronously a few at a time. The game thread only takes a snapshot of their comments;
+ * records are built from the snapshots and indexed on worker tasks into
+ * immutable shards, each holding its own lowercase inverted index. Queries run on worker tasks,
+ * one per shard, and hand their hits back to the game thread as each shard finishes. Shards that
+ * are built while a query is active are searched as soon as they arrive.
+ */
+class FPropertyCommentSearch : public TSharedFromThis<FPropertyCommentSearch, ESPMode::ThreadSafe>
+{
+public:
+	/** Discards the current index and rescans the project. Game thread only. */
+	void StartScan();
+
+	/** Stops loading packages and drops every pending result. Game thread only. */
+	void Cancel();
+
+	/** Replaces the current query. Results are delivered through OnResults, possibly in several batches. */
+	void SetQuery(const FString& InQuery);
+
+	FOnPropertyCommentSearchResults& OnResults();
+	FSimpleDelegate& OnQueryReset();
+
+	bool IsScanning() const;
+	int32 GetNumPendingPackages() const;
+	int32 GetNumIndexedComments() const;
+
+private:
+	struct FShard;
+	using FShardRef = TSharedRef<const FShard, ESPMode::ThreadSafe>;
+
+	void LoadIndexCache(const TArray<FString>& SavedHashes);
+	void HandleIndexCacheLoaded(const TArray<int32>& StalePackages, const TArray<FName>& CachedPackages, const TArray<FShardRef>& CachedShards, bool bCacheOutdated);
+	void SaveIndexCacheIfComplete();
+	void PumpPackageLoads();
+	void HandlePackageLoaded(const FName& PackageName, UPackage* Package, int32 Result, FAssetData AssetData);
+	void ExtractComments(const FAssetData& AssetData);
+	void FlushPendingRecords(bool bForce);
+	void AddShard(FShardRef Shard);
+	void LaunchQuery(const FShardRef& Shard);
+
+	static FShardRef BuildShard(const TArray<FPropertyCommentSnapshotRef>& Snapshots);
+	static FShardRef BuildShardFromRecords(TArray<FPropertyCommentSearchRecord>&& Records);
+	static void QueryShard(const FShardRef& Shard, const TArray<FString>& Tokens, TArray<FPropertyCommentSearchResult>& OutResults);
+
+	/** Packages waiting for the index cache to tell whether they have to be loaded. */
+	TArray<FAssetData> PackagesToCheck;
+	bool bLoadingIndexCache = false;
+
+	/** Saved hash of every package whose comments may go to the index cache, which excludes unsaved ones. */
+	TMap<FName, FString> CacheableHashes;
+
+	/** Cacheable packages whose comments made it into the shards, from the cache or from the package. */
+	TSet<FName> IndexedPackages;
+	bool bIndexCacheOutdated = false;
+
+	TArray<FAssetData> PackagesToLoad;
+	int32 NumInFlightLoads = 0;
+	int32 NumShardsBuilding = 0;
+	TArray<FPropertyCommentSnapshotRef> PendingSnapshots;
+	int32 NumPendingRecords = 0;
+
+	TArray<FShardRef> Shards;
+	int32 NumIndexedComments = 0;
+
+	FString Query;
+	uint32 QueryId = 0;
+	uint32 ScanId = 0;
+
+	FOnPropertyCommentSearchResults ResultsDelegate;
+	FSimpleDelegate QueryResetDelegate;
+};
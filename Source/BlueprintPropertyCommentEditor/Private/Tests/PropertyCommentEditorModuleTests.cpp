@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintPropertyCommentEditor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintEditorModule.h"
+#include "Editor.h"
+#include "Framework/Docking/TabManager.h"
+#include "Misc/AutomationTest.h"
+#include "PropertyCommentRenameHandler.h"
+#include "PropertyEditorModule.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertyCommentDeferredHooksTest, "BlueprintPropertyComment.Editor.DeferredHooks",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPropertyCommentDeferredHooksTest::RunTest(const FString& Parameters)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const bool bPropertyEditorLoaded = FModuleManager::Get().IsModuleLoaded("PropertyEditor");
+	const bool bKismetLoaded = FModuleManager::Get().IsModuleLoaded("Kismet");
+
+	// A second instance next to the live module, which keeps its own registrations untouched. Every
+	// hook is bound to the instance, so the checks below only see what this one registered.
+	FBlueprintPropertyCommentEditorModule Module;
+	Module.StartupModule();
+
+	TestEqual(TEXT("StartupModule leaves the property editor as it found it"), FModuleManager::Get().IsModuleLoaded("PropertyEditor"), bPropertyEditorLoaded);
+	TestEqual(TEXT("StartupModule leaves the blueprint editor as it found it"), FModuleManager::Get().IsModuleLoaded("Kismet"), bKismetLoaded);
+	TestEqual(TEXT("Module loads are only watched while an editor module is missing"), FModuleManager::Get().OnModulesChanged().IsBoundToObject(&Module), !bPropertyEditorLoaded || !bKismetLoaded);
+	TestEqual(TEXT("The rename handler exists once the blueprint editor is loaded"), Module.RenameHandler.IsValid(), bKismetLoaded);
+
+	TestFalse(TEXT("Session hooks are flagged after StartupModule"), Module.bSessionHooksRegistered);
+	TestFalse(TEXT("Asset removal is hooked after StartupModule"), AssetRegistry.OnAssetRemoved().IsBoundToObject(&Module));
+	TestFalse(TEXT("Asset renames are hooked after StartupModule"), AssetRegistry.OnAssetRenamed().IsBoundToObject(&Module));
+	if (GEditor)
+	{
+		TestFalse(TEXT("Blueprint compiles are hooked after StartupModule"), GEditor->OnBlueprintCompiled().IsBoundToObject(&Module));
+	}
+
+	if (bPropertyEditorLoaded)
+	{
+		FPropertyEditorModule& PropertyEditor = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+		TestTrue(TEXT("The row extension is registered once the property editor is loaded"), PropertyEditor.GetGlobalRowExtensionDelegate().IsBoundToObject(&Module));
+	}
+	if (bKismetLoaded)
+	{
+		FBlueprintEditorModule& BlueprintEditor = FModuleManager::GetModuleChecked<FBlueprintEditorModule>("Kismet");
+		TestTrue(TEXT("The tab factories are registered once the blueprint editor is loaded"), BlueprintEditor.OnRegisterTabsForEditor().IsBoundToObject(&Module));
+	}
+
+	// Creates the first row the way a details panel does, the row itself is discarded
+	TArray<FPropertyRowExtensionButton> Extensions;
+	Module.HandleCreatePropertyRowExtension(FOnGenerateGlobalRowExtensionArgs{}, Extensions);
+
+	TestEqual(TEXT("The first row gets a comment button"), Extensions.Num(), 1);
+	TestTrue(TEXT("Session hooks are flagged after the first row"), Module.bSessionHooksRegistered);
+	TestTrue(TEXT("Asset removal is hooked after the first row"), AssetRegistry.OnAssetRemoved().IsBoundToObject(&Module));
+	TestTrue(TEXT("Asset renames are hooked after the first row"), AssetRegistry.OnAssetRenamed().IsBoundToObject(&Module));
+	if (GEditor)
+	{
+		TestTrue(TEXT("Blueprint compiles are hooked after the first row"), GEditor->OnBlueprintCompiled().IsBoundToObject(&Module));
+	}
+
+	Extensions.Reset();
+	Module.ShutdownModule();
+
+	TestFalse(TEXT("Module loads are not watched after ShutdownModule"), FModuleManager::Get().OnModulesChanged().IsBoundToObject(&Module));
+	TestFalse(TEXT("Asset removal is not hooked after ShutdownModule"), AssetRegistry.OnAssetRemoved().IsBoundToObject(&Module));
+	TestFalse(TEXT("Asset renames are not hooked after ShutdownModule"), AssetRegistry.OnAssetRenamed().IsBoundToObject(&Module));
+	if (bPropertyEditorLoaded)
+	{
+		FPropertyEditorModule& PropertyEditor = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+		TestFalse(TEXT("The row extension is removed by ShutdownModule"), PropertyEditor.GetGlobalRowExtensionDelegate().IsBoundToObject(&Module));
+	}
+	TestTrue(TEXT("The search tab of the live module survives ShutdownModule of another instance"),
+		!FModuleManager::Get().IsModuleLoaded("BlueprintPropertyCommentEditor") || FGlobalTabmanager::Get()->HasTabSpawner("PropertyCommentSearch"));
+
+	return true;
+}
+
+#endif
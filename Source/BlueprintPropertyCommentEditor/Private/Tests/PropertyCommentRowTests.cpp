@@ -0,0 +1,181 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BlueprintPropertyCommentEditor.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentRow.h"
+#include "PropertyCommentSyntheticBlueprint.h"
+#include "IPropertyRowGenerator.h"
+#include "PropertyEditorModule.h"
+#include "PropertyHandle.h"
+#include "Engine/Blueprint.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** The rows a details panel would show for the class default object of a small synthetic blueprint. */
+	struct FSyntheticPanel
+	{
+		FSyntheticPanel()
+			: Blueprint(PropertyCommentSyntheticBlueprint::Create(8, 2, 2))
+			, RowGenerator(FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor").CreatePropertyRowGenerator(FPropertyRowGeneratorArgs{}))
+		{
+			RowGenerator->SetObjects({Blueprint->GeneratedClass->GetDefaultObject()});
+			PropertyCommentSyntheticBlueprint::GatherPropertyHandles(RowGenerator->GetRootTreeNodes(), Handles);
+		}
+
+		/** First handle whose path starts with the given property and has the given number of segments. */
+		TSharedPtr<IPropertyHandle> FindHandle(FName RootName, int32 NumSegments) const
+		{
+			for (const TSharedPtr<IPropertyHandle>& Handle : Handles)
+			{
+				const FPropertyCommentPath Path = FPropertyCommentRow::GetPropertyPathRecursive(Handle);
+				if (Path.Segments.Num() == NumSegments && Path.Segments[0].Name == RootName)
+				{
+					return Handle;
+				}
+			}
+			return nullptr;
+		}
+
+		TStrongObjectPtr<UBlueprint> Blueprint;
+		TSharedRef<IPropertyRowGenerator> RowGenerator;
+		TArray<TSharedPtr<IPropertyHandle>> Handles;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertyCommentRowPathTest, "BlueprintPropertyComment.Editor.CommentRow.PropertyPath",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPropertyCommentRowPathTest::RunTest(const FString& Parameters)
+{
+	const FSyntheticPanel Panel;
+	if (!TestTrue(TEXT("The synthetic blueprint produces rows"), Panel.Handles.Num() > 0))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Path of a top level property"), FPropertyCommentRow::GetPropertyPathRecursive(Panel.FindHandle("Property3", 1)).ToString(), FString{TEXT("Property3")});
+	TestTrue(TEXT("Path of a null handle is empty"), FPropertyCommentRow::GetPropertyPathRecursive(nullptr).IsEmpty());
+
+	for (const TSharedPtr<IPropertyHandle>& Handle : Panel.Handles)
+	{
+		const FPropertyCommentPath Path = FPropertyCommentRow::GetPropertyPathRecursive(Handle);
+		const FString PathString = Path.ToString();
+
+		TestTrue(FString::Printf(TEXT("%s resolves to the property of its row"), *PathString), Path.Resolve(Panel.Blueprint->GeneratedClass) == Handle->GetProperty());
+		TestTrue(FString::Printf(TEXT("%s survives a round trip through its string form"), *PathString), FPropertyCommentPath::FromString(PathString) == Path);
+		if (Handle->GetIndexInArray() != INDEX_NONE)
+		{
+			TestEqual(FString::Printf(TEXT("%s ends with the element index"), *PathString), Path.Segments.Last().ArrayIndex, Handle->GetIndexInArray());
+		}
+
+		// A child row extends the path of its parent row by exactly one segment
+		if (const TSharedPtr<IPropertyHandle> Parent = Handle->GetParentHandle(); Parent && Parent->IsValidHandle() && Parent->GetProperty())
+		{
+			const FPropertyCommentPath ParentPath = FPropertyCommentRow::GetPropertyPathRecursive(Parent);
+			FPropertyCommentPath PathPrefix = Path;
+			PathPrefix.Segments.SetNum(FMath::Min(Path.Segments.Num(), ParentPath.Segments.Num()));
+			TestEqual(FString::Printf(TEXT("%s is one segment longer than its parent"), *PathString), Path.Segments.Num(), ParentPath.Segments.Num() + 1);
+			TestTrue(FString::Printf(TEXT("%s starts with the path of its parent"), *PathString), PathPrefix == ParentPath);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertyCommentRowDisplayTest, "BlueprintPropertyComment.Editor.CommentRow.Display",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPropertyCommentRowDisplayTest::RunTest(const FString& Parameters)
+{
+	FBlueprintPropertyCommentEditorModule& Module = FModuleManager::GetModuleChecked<FBlueprintPropertyCommentEditorModule>("BlueprintPropertyCommentEditor");
+	const FSyntheticPanel Panel;
+
+	const TSharedPtr<IPropertyHandle> StructHandle = Panel.FindHandle("Property0", 1);
+	const TSharedPtr<IPropertyHandle> MemberHandle = Panel.FindHandle("Property0", 2);
+	const TSharedPtr<IPropertyHandle> IntegerHandle = Panel.FindHandle("Property3", 1);
+	if (!TestTrue(TEXT("The synthetic blueprint has struct, member and integer rows"), StructHandle && MemberHandle && IntegerHandle))
+	{
+		return false;
+	}
+
+	const TSharedRef<FPropertyCommentRow> StructRow = MakeShared<FPropertyCommentRow>(StructHandle, Module.BlueprintResolveCache);
+	const TSharedRef<FPropertyCommentRow> MemberRow = MakeShared<FPropertyCommentRow>(MemberHandle, Module.BlueprintResolveCache);
+	const TSharedRef<FPropertyCommentRow> IntegerRow = MakeShared<FPropertyCommentRow>(IntegerHandle, Module.BlueprintResolveCache);
+
+	TestTrue(TEXT("The row resolves to the synthetic blueprint"), IntegerRow->GetBlueprint() == Panel.Blueprint.Get());
+	TestTrue(TEXT("A row of a blueprint can be clicked"), Module.CanClickComment(IntegerRow));
+	TestEqual(TEXT("Icon without comments"), Module.GetCommentIcon(IntegerRow).GetStyleName(), FName{"Icons.Toolbar.Details"});
+	TestEqual(TEXT("Tooltip without comments"), Module.GetCommentTooltip(IntegerRow).ToString(), FString{TEXT("Click to add comment")});
+
+	const FText Comment = FText::AsCultureInvariant(TEXT("Synthetic member comment"));
+	UPropertyCommentExtension::GetOrCreatePropertyCommentExtension(Panel.Blueprint.Get())->AddComment(MemberRow->GetPropertyPath(), Comment);
+
+	TestEqual(TEXT("Icon of the commented row"), Module.GetCommentIcon(MemberRow).GetStyleName(), FName{"Icons.Comment"});
+	TestEqual(TEXT("Tooltip of the commented row"), Module.GetCommentTooltip(MemberRow).ToString(), Comment.ToString());
+
+	TestEqual(TEXT("Icon of the parent of the commented row"), Module.GetCommentIcon(StructRow).GetStyleName(), FName{"Icons.Info"});
+	TestTrue(TEXT("Tooltip of the parent of the commented row counts the nested comment"), Module.GetCommentTooltip(StructRow).ToString().StartsWith(TEXT("1 nested property has comments")));
+
+	TestEqual(TEXT("Icon of an unrelated row"), Module.GetCommentIcon(IntegerRow).GetStyleName(), FName{"Icons.Toolbar.Details"});
+	TestEqual(TEXT("Tooltip of an unrelated row"), Module.GetCommentTooltip(IntegerRow).ToString(), FString{TEXT("Click to add comment")});
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPropertyCommentRowInvalidationTest, "BlueprintPropertyComment.Editor.CommentRow.Invalidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPropertyCommentRowInvalidationTest::RunTest(const FString& Parameters)
+{
+	FBlueprintPropertyCommentEditorModule& Module = FModuleManager::GetModuleChecked<FBlueprintPropertyCommentEditorModule>("BlueprintPropertyCommentEditor");
+	const FSyntheticPanel Panel;
+
+	const TSharedPtr<IPropertyHandle> IntegerHandle = Panel.FindHandle("Property3", 1);
+	if (!TestTrue(TEXT("The synthetic blueprint has an integer row"), IntegerHandle.IsValid()))
+	{
+		return false;
+	}
+
+	const TSharedRef<FPropertyCommentRow> Row = MakeShared<FPropertyCommentRow>(IntegerHandle, Module.BlueprintResolveCache);
+	TestTrue(TEXT("A new row has no icon yet"), Row->IsIconStale());
+	TestTrue(TEXT("A new row has no tooltip yet"), Row->IsTooltipStale());
+
+	Module.GetCommentIcon(Row);
+	TestFalse(TEXT("The icon is cached once computed"), Row->IsIconStale());
+	TestTrue(TEXT("Computing the icon leaves the tooltip alone"), Row->IsTooltipStale());
+
+	Module.GetCommentTooltip(Row);
+	TestFalse(TEXT("The tooltip is cached once computed"), Row->IsTooltipStale());
+
+	// A comment change anywhere bumps the global comment revision
+	const FText Comment = FText::AsCultureInvariant(TEXT("Synthetic integer comment"));
+	UPropertyCommentExtension* Extension = UPropertyCommentExtension::GetOrCreatePropertyCommentExtension(Panel.Blueprint.Get());
+	Extension->AddComment(Row->GetPropertyPath(), Comment);
+
+	TestTrue(TEXT("Adding a comment invalidates the icon"), Row->IsIconStale());
+	TestTrue(TEXT("Adding a comment invalidates the tooltip"), Row->IsTooltipStale());
+	TestEqual(TEXT("Icon after adding a comment"), Module.GetCommentIcon(Row).GetStyleName(), FName{"Icons.Comment"});
+	TestEqual(TEXT("Tooltip after adding a comment"), Module.GetCommentTooltip(Row).ToString(), Comment.ToString());
+
+	// What the blueprint compile and reinstance events run
+	Module.InvalidateResolvedBlueprints();
+
+	TestTrue(TEXT("A compile invalidates the icon"), Row->IsIconStale());
+	TestTrue(TEXT("A compile invalidates the tooltip"), Row->IsTooltipStale());
+	TestEqual(TEXT("Icon after a compile"), Module.GetCommentIcon(Row).GetStyleName(), FName{"Icons.Comment"});
+	TestEqual(TEXT("Tooltip after a compile"), Module.GetCommentTooltip(Row).ToString(), Comment.ToString());
+
+	Extension->RemoveComment(Row->GetPropertyPath());
+
+	TestTrue(TEXT("Removing a comment invalidates the icon"), Row->IsIconStale());
+	TestEqual(TEXT("Icon after removing the comment"), Module.GetCommentIcon(Row).GetStyleName(), FName{"Icons.Toolbar.Details"});
+	TestEqual(TEXT("Tooltip after removing the comment"), Module.GetCommentTooltip(Row).ToString(), FString{TEXT("Click to add comment")});
+
+	return true;
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Input/SEditableText.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
+#include "Widgets/Layout/SBox.h"
 
 #define LOCTEXT_NAMESPACE "SCommentEditOverlay"
 
@@ -15,13 +16,8 @@ void SCommentEditOverlay::Construct(const FArguments& InArgs)
 {
 	ParentWindow = InArgs._ParentWindow;
 	MaxCharacterCount = FMath::Max(0, InArgs._MaxCharacterCount);
-	OnConfirmClicked = InArgs._OnConfirmClicked;
-	OnCancelClicked = InArgs._OnCancelClicked;
-	OnRemoveClicked = InArgs._OnRemoveClicked;
-	InitialComment = InArgs._Content;
 
 	TSharedPtr<SOverlay> Overlay;
-	TSharedPtr<SHorizontalBox> ButtonSection;
 
 	ChildSlot
 	[
@@ -53,13 +49,27 @@ void SCommentEditOverlay::Construct(const FArguments& InArgs)
 						.VAlign(VAlign_Bottom)
 						.HAlign(HAlign_Fill)
 						[
-							SAssignNew(ButtonSection, SHorizontalBox)
+							SNew(SHorizontalBox)
 							+SHorizontalBox::Slot()
 							.VAlign(VAlign_Bottom)
 							.HAlign(HAlign_Left)
 							[
 								CreateCancelButtonWidget().ToSharedRef()
 							]
+
+							+SHorizontalBox::Slot()
+							.VAlign(VAlign_Bottom)
+							.HAlign(HAlign_Right)
+							[
+								CreateRemoveButtonWidget().ToSharedRef()
+							]
+
+							+SHorizontalBox::Slot()
+							.VAlign(VAlign_Bottom)
+							.HAlign(HAlign_Right)
+							[
+								CreateConfirmButtonWidget().ToSharedRef()
+							]
 						]
 					]
 				]
@@ -67,22 +77,7 @@ void SCommentEditOverlay::Construct(const FArguments& InArgs)
 		]
 	];
 
-	if (!InitialComment.IsEmpty())
-	{
-		ButtonSection->AddSlot()
-		.VAlign(VAlign_Bottom)
-		.HAlign(HAlign_Right)
-		[
-			CreateRemoveButtonWidget().ToSharedRef()
-		];
-	}
-
-	ButtonSection->AddSlot()
-	.VAlign(VAlign_Bottom)
-	.HAlign(HAlign_Right)
-	[
-		CreateConfirmButtonWidget().ToSharedRef()
-	];
+	Retarget(InArgs._Content, InArgs._OnConfirmClicked, InArgs._OnCancelClicked, InArgs._OnRemoveClicked);
 }
 
 TWeakPtr<SWindow> SCommentEditOverlay::GetParentWindow() const
@@ -90,6 +85,34 @@ TWeakPtr<SWindow> SCommentEditOverlay::GetParentWindow() const
 	return ParentWindow;
 }
 
+void SCommentEditOverlay::Retarget(const FText& Content, FOnConfirmAddComment InOnConfirmClicked, FOnCancelAddComment InOnCancelClicked, FSimpleDelegate InOnRemoveClicked)
+{
+	OnConfirmClicked = MoveTemp(InOnConfirmClicked);
+	OnCancelClicked = MoveTemp(InOnCancelClicked);
+	OnRemoveClicked = MoveTemp(InOnRemoveClicked);
+	InitialComment = Content;
+	InitialString = Content.ToString();
+
+	// The text box keeps its undo history across SetText, a new one starts without any
+	CommentTextBoxContainer->SetContent(CreateCommentTextBox());
+	CommentTextBox->SetText(InitialComment);
+	bCommentChanged = false;
+}
+
+void SCommentEditOverlay::HandleTextChanged(const FText& Text)
+{
+	const FString& String = Text.ToString();
+	if (String.Len() > MaxCharacterCount)
+	{
+		// Setting the truncated text calls back in here, which updates the state
+		CommentTextBox->SetText(FText::FromString(String.Left(MaxCharacterCount)));
+		return;
+	}
+
+	// Texts of different length are told apart without looking at the characters
+	bCommentChanged = String.Len() != InitialString.Len() || FCString::Strcmp(*String, *InitialString) != 0;
+}
+
 TSharedPtr<SWidget> SCommentEditOverlay::CreateCommentWidget()
 {
 	return SNew(SBorder)
@@ -111,25 +134,21 @@ TSharedPtr<SWidget> SCommentEditOverlay::CreateCommentWidget()
 			.HAlign(HAlign_Fill)
 			.VAlign(VAlign_Fill)
 			[
-				SAssignNew(CommentTextBox, SMultiLineEditableTextBox)
-				.Visibility(EVisibility::SelfHitTestInvisible)
-				.AutoWrapText(true)
-				.Text(InitialComment)
-				.TextStyle(FEditorStyle::Get(), "Tutorials.Content")
-				.OnTextChanged_Lambda([this](const FText& Text)
-				{
-					FString Str = Text.ToString();
-					if (Str.Len() > MaxCharacterCount)
-					{
-						Str.LeftInline(MaxCharacterCount);
-						CommentTextBox->SetText(FText::FromString(Str));
-					}
-				})
+				SAssignNew(CommentTextBoxContainer, SBox)
 			]
 		]
 	];
 }
 
+TSharedRef<SMultiLineEditableTextBox> SCommentEditOverlay::CreateCommentTextBox()
+{
+	return SAssignNew(CommentTextBox, SMultiLineEditableTextBox)
+	.Visibility(EVisibility::SelfHitTestInvisible)
+	.AutoWrapText(true)
+	.TextStyle(FEditorStyle::Get(), "Tutorials.Content")
+	.OnTextChanged(this, &SCommentEditOverlay::HandleTextChanged);
+}
+
 TSharedPtr<SWidget> SCommentEditOverlay::CreateCancelButtonWidget()
 {
 	return SNew(SButton)
@@ -175,6 +194,10 @@ TSharedPtr<SWidget> SCommentEditOverlay::CreateCancelButtonWidget()
 TSharedPtr<SWidget> SCommentEditOverlay::CreateRemoveButtonWidget()
 {
 	return SNew(SButton)
+	.Visibility_Lambda([this]()
+	{
+		return InitialComment.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
+	})
 	.OnClicked_Lambda([this]()
 	{
 		OnRemoveClicked.ExecuteIfBound();
@@ -215,8 +238,7 @@ TSharedPtr<SWidget> SCommentEditOverlay::CreateRemoveButtonWidget()
 
 bool SCommentEditOverlay::CommentHasChanged() const
 {
-	const FText CurrentText = CommentTextBox->GetText();
-	return CurrentText.CompareTo(InitialComment) != 0;
+	return bCommentChanged;
 }
 
 TSharedPtr<SWidget> SCommentEditOverlay::CreateConfirmButtonWidget()
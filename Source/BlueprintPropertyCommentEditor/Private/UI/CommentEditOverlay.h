@@ -6,6 +6,7 @@
 #include "Layout/Visibility.h"
 #include "Widgets/SCompoundWidget.h"
 
+class SBox;
 class SMultiLineEditableTextBox;
 class SCanvas;
 class SWindow;
@@ -34,13 +35,18 @@ public:
 	void Construct(const FArguments& InArgs);
 	TWeakPtr<SWindow> GetParentWindow() const;
 
+	/** Points the overlay at another comment. The widgets are kept, only the text and the handlers change. */
+	void Retarget(const FText& Content, FOnConfirmAddComment InOnConfirmClicked, FOnCancelAddComment InOnCancelClicked, FSimpleDelegate InOnRemoveClicked);
+
 private:
 	TSharedPtr<SWidget> CreateCommentWidget();
+	TSharedRef<SMultiLineEditableTextBox> CreateCommentTextBox();
 	TSharedPtr<SWidget> CreateConfirmButtonWidget();
 	TSharedPtr<SWidget> CreateCancelButtonWidget();
 	TSharedPtr<SWidget> CreateRemoveButtonWidget();
 
 	bool CommentHasChanged() const;
+	void HandleTextChanged(const FText& Text);
 
 	TSharedPtr<SCanvas> OverlayCanvas;
 	TWeakPtr<SWindow> ParentWindow;
@@ -49,7 +55,13 @@ private:
 	FOnCancelAddComment OnCancelClicked;
 	FSimpleDelegate OnRemoveClicked;
 
+	/** Holds the text box, which is replaced on retarget so that undo cannot bring back the previous comment. */
+	TSharedPtr<SBox> CommentTextBoxContainer;
 	TSharedPtr<SMultiLineEditableTextBox> CommentTextBox;
 	int32 MaxCharacterCount;
 	FText InitialComment;
+	FString InitialString;
+
+	/** Updated once per edit, so that the confirm button does not compare the whole comment every frame. */
+	bool bCommentChanged = false;
 };
\ No newline at end of file
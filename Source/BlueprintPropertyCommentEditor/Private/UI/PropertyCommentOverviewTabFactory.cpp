@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UI/PropertyCommentOverviewTabFactory.h"
+
+#include "BlueprintEditor.h"
+#include "UI/SPropertyCommentOverview.h"
+
+#define LOCTEXT_NAMESPACE "PropertyCommentOverviewTabFactory"
+
+const FName FPropertyCommentOverviewTabFactory::TabId{"PropertyCommentOverview"};
+
+FPropertyCommentOverviewTabFactory::FPropertyCommentOverviewTabFactory(TSharedPtr<FBlueprintEditor> InBlueprintEditor)
+	: FWorkflowTabFactory(TabId, InBlueprintEditor)
+	, BlueprintEditor(InBlueprintEditor)
+{
+	TabLabel = LOCTEXT("TabLabel", "Property Comments");
+	TabIcon = FSlateIcon(FAppStyle::Get().GetStyleSetName(), "Icons.Comment");
+	bIsSingleton = true;
+
+	ViewMenuDescription = LOCTEXT("ViewMenuDescription", "Property Comments");
+	ViewMenuTooltip = LOCTEXT("ViewMenuTooltip", "Show the property comments of this blueprint");
+}
+
+TSharedRef<SWidget> FPropertyCommentOverviewTabFactory::CreateTabBody(const FWorkflowTabSpawnInfo& Info) const
+{
+	return SNew(SPropertyCommentOverview, BlueprintEditor.Pin());
+}
+
+FText FPropertyCommentOverviewTabFactory::GetTabToolTipText(const FWorkflowTabSpawnInfo& Info) const
+{
+	return LOCTEXT("TabTooltip", "Lists the property comments of this blueprint. Click a comment to show its property in the details panel.");
+}
+
+#undef LOCTEXT_NAMESPACE
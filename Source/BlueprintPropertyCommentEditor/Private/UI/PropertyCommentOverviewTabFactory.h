@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorkflowOrientedApp/WorkflowTabFactory.h"
+
+class FBlueprintEditor;
+
+/** Adds the comment overview of the edited blueprint to the Window menu of the blueprint editor. */
+class FPropertyCommentOverviewTabFactory : public FWorkflowTabFactory
+{
+public:
+	static const FName TabId;
+
+	explicit FPropertyCommentOverviewTabFactory(TSharedPtr<FBlueprintEditor> InBlueprintEditor);
+
+	//~ Begin FWorkflowTabFactory Interface
+	virtual TSharedRef<SWidget> CreateTabBody(const FWorkflowTabSpawnInfo& Info) const override;
+	virtual FText GetTabToolTipText(const FWorkflowTabSpawnInfo& Info) const override;
+	//~ End FWorkflowTabFactory Interface
+
+private:
+	TWeakPtr<FBlueprintEditor> BlueprintEditor;
+};
@@ -0,0 +1,391 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UI/SPropertyCommentOverview.h"
+
+#include "Algo/BinarySearch.h"
+#include "BlueprintEditor.h"
+#include "EditorStyleSet.h"
+#include "Engine/Blueprint.h"
+#include "IDetailsView.h"
+#include "PropertyCommentExtension.h"
+#include "PropertyCommentResolver.h"
+#include "PropertyCommentTokenizer.h"
+#include "PropertyPath.h"
+#include "SKismetInspector.h"
+#include "UI/SPropertyCommentPreview.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "SPropertyCommentOverview"
+
+namespace
+{
+	/** Chain of properties the details panel uses to find the row of the path, or null if the path does not resolve. */
+	TSharedPtr<FPropertyPath> MakeDetailsPropertyPath(const UStruct* Root, const FPropertyCommentPath& PropertyPath)
+	{
+		TSharedRef<FPropertyPath> DetailsPath = FPropertyPath::CreateEmpty();
+
+		FPropertyCommentPath Prefix;
+		for (const FPropertyCommentPathSegment& Segment : PropertyPath.Segments)
+		{
+			Prefix.Segments.Add(Segment);
+			const FProperty* Property = Prefix.Resolve(Root);
+			if (!Property)
+			{
+				return nullptr;
+			}
+
+			DetailsPath->AddProperty(FPropertyInfo(const_cast<FProperty*>(Property), Segment.ArrayIndex));
+		}
+		return DetailsPath;
+	}
+
+	/** Position of the key in items sorted by key, or where it would be inserted. */
+	int32 LowerBoundByKey(const TArray<SPropertyCommentOverview::FItemPtr>& SortedItems, const FString& Key)
+	{
+		return Algo::LowerBound(SortedItems, Key, [](const SPropertyCommentOverview::FItemPtr& Item, const FString& Value)
+		{
+			return Item->Key.Compare(Value, ESearchCase::IgnoreCase) < 0;
+		});
+	}
+}
+
+void SPropertyCommentOverview::Construct(const FArguments& InArgs, TSharedPtr<FBlueprintEditor> InBlueprintEditor)
+{
+	BlueprintEditor = InBlueprintEditor;
+	Blueprint = InBlueprintEditor.IsValid() ? InBlueprintEditor->GetBlueprintObj() : nullptr;
+
+	UPropertyCommentExtension::OnCommentsChanged().AddSP(this, &SPropertyCommentOverview::HandleCommentsChanged);
+	if (UBlueprint* BlueprintObj = Blueprint.Get())
+	{
+		BlueprintObj->OnCompiled().AddSP(this, &SPropertyCommentOverview::HandleBlueprintChanged);
+	}
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(SSearchBox)
+			.HintText(LOCTEXT("FilterHint", "Filter by property or comment"))
+			.OnTextChanged(this, &SPropertyCommentOverview::OnFilterTextChanged)
+		]
+
+		+SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			SAssignNew(ListView, SListView<FItemPtr>)
+			.ListItemsSource(&Items)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SPropertyCommentOverview::OnGenerateRow)
+			.OnMouseButtonClick(this, &SPropertyCommentOverview::OnItemClicked)
+			.HeaderRow
+			(
+				SNew(SHeaderRow)
+				+SHeaderRow::Column("Key")
+				.FillWidth(0.4f)
+				.DefaultLabel(LOCTEXT("KeyColumn", "Property"))
+
+				+SHeaderRow::Column("Comment")
+				.FillWidth(0.6f)
+				.DefaultLabel(LOCTEXT("CommentColumn", "Comment"))
+			)
+		]
+
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(STextBlock)
+			.Text(this, &SPropertyCommentOverview::GetStatusText)
+		]
+	];
+
+	RebuildItems();
+}
+
+SPropertyCommentOverview::~SPropertyCommentOverview()
+{
+	UPropertyCommentExtension::OnCommentsChanged().RemoveAll(this);
+	if (UBlueprint* BlueprintObj = Blueprint.Get())
+	{
+		BlueprintObj->OnCompiled().RemoveAll(this);
+	}
+}
+
+void SPropertyCommentOverview::RebuildItems()
+{
+	AllItems.Reset();
+
+	const UBlueprint* BlueprintObj = Blueprint.Get();
+	const UPropertyCommentExtension* Extension = BlueprintObj ? UPropertyCommentExtension::GetPropertyCommentExtension(BlueprintObj) : nullptr;
+	if (IsValid(Extension))
+	{
+		// Only the keys are gathered, the texts stay unloaded until a row shows them
+		AllItems.Reserve(Extension->GetNumComments());
+		Extension->ForEachCommentedPath([this](const FPropertyCommentPath& PropertyPath)
+		{
+			FItemPtr Item = MakeShared<FPropertyCommentOverviewItem>();
+			Item->PropertyPath = PropertyPath;
+			Item->Key = PropertyPath.ToString();
+			AllItems.Add(MoveTemp(Item));
+		});
+
+		AllItems.Sort([](const FItemPtr& A, const FItemPtr& B)
+		{
+			return A->Key.Compare(B->Key, ESearchCase::IgnoreCase) < 0;
+		});
+	}
+
+	ApplyFilter();
+}
+
+void SPropertyCommentOverview::ApplyFilter()
+{
+	Items.Reset();
+
+	const UBlueprint* BlueprintObj = Blueprint.Get();
+	const UPropertyCommentExtension* Extension = BlueprintObj ? UPropertyCommentExtension::GetPropertyCommentExtension(BlueprintObj) : nullptr;
+	if (FilterText.IsEmpty() || !IsValid(Extension))
+	{
+		Items = AllItems;
+	}
+	else
+	{
+		// Comment words are probed in the token index, no comment text is looked at here
+		TArray<FPropertyCommentPath> MatchingPaths;
+		Extension->FindCommentsMatching(FilterQuery, MatchingPaths);
+		const TSet<FPropertyCommentPath> CommentMatches{MatchingPaths};
+
+		for (const FItemPtr& Item : AllItems)
+		{
+			if (CommentMatches.Contains(Item->PropertyPath) || Item->Key.Contains(FilterText))
+			{
+				Items.Add(Item);
+			}
+		}
+	}
+
+	ListView->RequestListRefresh();
+}
+
+void SPropertyCommentOverview::OnFilterTextChanged(const FText& InText)
+{
+	FilterQuery = InText.ToString().TrimStart();
+	FilterText = FilterQuery.TrimEnd();
+	ApplyFilter();
+}
+
+void SPropertyCommentOverview::UpdateItem(const UPropertyCommentExtension& Extension, const FPropertyCommentPath& PropertyPath)
+{
+	const FString Key = PropertyPath.ToString();
+	const int32 Index = LowerBoundByKey(AllItems, Key);
+	const bool bListed = AllItems.IsValidIndex(Index) && AllItems[Index]->PropertyPath == PropertyPath;
+	const int32 FilteredIndex = LowerBoundByKey(Items, Key);
+	const bool bShown = Items.IsValidIndex(FilteredIndex) && Items[FilteredIndex]->PropertyPath == PropertyPath;
+
+	if (bShown)
+	{
+		Items.RemoveAt(FilteredIndex);
+	}
+
+	if (!Extension.HasComment(PropertyPath))
+	{
+		if (bListed)
+		{
+			AllItems.RemoveAt(Index);
+		}
+	}
+	else
+	{
+		// A new item for a changed comment too, so that the list view generates its row again
+		FItemPtr Item = MakeShared<FPropertyCommentOverviewItem>();
+		Item->PropertyPath = PropertyPath;
+		Item->Key = Key;
+		if (bListed)
+		{
+			Item->bResolves = AllItems[Index]->bResolves;
+			AllItems[Index] = Item;
+		}
+		else
+		{
+			AllItems.Insert(Item, Index);
+		}
+
+		if (PassesFilter(Extension, *Item))
+		{
+			Items.Insert(MoveTemp(Item), FilteredIndex);
+		}
+	}
+
+	ListView->RequestListRefresh();
+}
+
+bool SPropertyCommentOverview::PassesFilter(const UPropertyCommentExtension& Extension, const FPropertyCommentOverviewItem& Item) const
+{
+	if (FilterText.IsEmpty() || Item.Key.Contains(FilterText))
+	{
+		return true;
+	}
+
+	const FText* Comment = Extension.FindComment(Item.PropertyPath);
+	if (!Comment)
+	{
+		return false;
+	}
+
+	// Same rule as the token index: every word of the filter, the last one also as a prefix until a space follows it
+	TArray<FString, TInlineAllocator<8>> FilterTokens;
+	PropertyCommentTokenizer::Tokenize(FilterQuery, FilterTokens);
+	TArray<FString> CommentTokens;
+	PropertyCommentTokenizer::Tokenize(Comment->ToString(), CommentTokens);
+	if (FilterTokens.Num() == 0)
+	{
+		return false;
+	}
+
+	const FString Prefix = FChar::IsWhitespace(FilterQuery[FilterQuery.Len() - 1]) ? FString() : FilterTokens.Pop(false);
+	for (const FString& Token : FilterTokens)
+	{
+		if (!CommentTokens.Contains(Token))
+		{
+			return false;
+		}
+	}
+	return Prefix.IsEmpty() || CommentTokens.ContainsByPredicate([&Prefix](const FString& Token)
+	{
+		return Token.StartsWith(Prefix, ESearchCase::CaseSensitive);
+	});
+}
+
+bool SPropertyCommentOverview::ResolveItem(FPropertyCommentOverviewItem& Item)
+{
+	if (!Item.bResolves.IsSet())
+	{
+		const UBlueprint* BlueprintObj = Blueprint.Get();
+		if (!BlueprintObj)
+		{
+			return false;
+		}
+
+		if (!Resolver)
+		{
+			Resolver = MakeUnique<FPropertyCommentResolver>(BlueprintObj);
+		}
+		Item.bResolves = Resolver->CanResolve(Item.PropertyPath);
+	}
+	return Item.bResolves.GetValue();
+}
+
+TSharedRef<ITableRow> SPropertyCommentOverview::OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	FText Comment;
+	const UBlueprint* BlueprintObj = Blueprint.Get();
+	if (const UPropertyCommentExtension* Extension = BlueprintObj ? UPropertyCommentExtension::GetPropertyCommentExtension(BlueprintObj) : nullptr)
+	{
+		if (const FText* FoundComment = Extension->FindComment(Item->PropertyPath))
+		{
+			Comment = *FoundComment;
+		}
+	}
+
+	const bool bResolves = ResolveItem(*Item);
+	const FText ToolTip = bResolves
+		? Comment
+		: FText::Format(LOCTEXT("UnresolvedTooltip", "This property no longer exists on the blueprint.\n\n{0}"), Comment);
+
+	return SNew(STableRow<FItemPtr>, OwnerTable)
+	.ToolTipText(ToolTip)
+	[
+		SNew(SHorizontalBox)
+		+SHorizontalBox::Slot()
+		.AutoWidth()
+		.VAlign(VAlign_Center)
+		.Padding(4.0f, 2.0f, 0.0f, 2.0f)
+		[
+			SNew(SImage)
+			.Image(FEditorStyle::GetBrush("Icons.Warning"))
+			.Visibility(bResolves ? EVisibility::Collapsed : EVisibility::Visible)
+		]
+
+		+SHorizontalBox::Slot()
+		.FillWidth(0.4f)
+		.Padding(4.0f, 2.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Item->Key))
+			.ColorAndOpacity(bResolves ? FSlateColor::UseForeground() : FSlateColor::UseSubduedForeground())
+		]
+
+		+SHorizontalBox::Slot()
+		.FillWidth(0.6f)
+		.Padding(4.0f, 2.0f)
+		[
+			SNew(SPropertyCommentPreview)
+			.Text(Comment)
+		]
+	];
+}
+
+void SPropertyCommentOverview::OnItemClicked(FItemPtr Item)
+{
+	TSharedPtr<FBlueprintEditor> Editor = BlueprintEditor.Pin();
+	const UBlueprint* BlueprintObj = Blueprint.Get();
+	if (!Item || !Editor || !BlueprintObj)
+	{
+		return;
+	}
+
+	Editor->StartEditingDefaults(/*bAutoFocus*/ true, /*bForceRefresh*/ true);
+
+	// Rows of component templates are only shown when their component is selected, those keys just open the defaults
+	const TSharedPtr<FPropertyPath> DetailsPath = MakeDetailsPropertyPath(BlueprintObj->GeneratedClass, Item->PropertyPath);
+	const TSharedPtr<SKismetInspector> Inspector = Editor->GetInspector();
+	if (DetailsPath && Inspector && Inspector->GetPropertyView())
+	{
+		Inspector->GetPropertyView()->HighlightProperty(*DetailsPath);
+	}
+}
+
+FText SPropertyCommentOverview::GetStatusText() const
+{
+	if (Items.Num() != AllItems.Num())
+	{
+		return FText::Format(LOCTEXT("FilteredStatus", "{0} of {1} comments"), Items.Num(), AllItems.Num());
+	}
+	return FText::Format(LOCTEXT("Status", "{0} {0}|plural(one=comment,other=comments)"), Items.Num());
+}
+
+void SPropertyCommentOverview::HandleCommentsChanged(UPropertyCommentExtension* Extension, const FPropertyCommentPath* ChangedPath)
+{
+	if (Extension->GetBlueprint() != Blueprint.Get())
+	{
+		return;
+	}
+
+	// Single edits move one item, only renames, undo and loads list the comments again
+	if (ChangedPath)
+	{
+		UpdateItem(*Extension, *ChangedPath);
+	}
+	else
+	{
+		RebuildItems();
+	}
+}
+
+void SPropertyCommentOverview::HandleBlueprintChanged(UBlueprint* InBlueprint)
+{
+	// The layout may have changed, resolve the keys again as their rows are shown
+	Resolver.Reset();
+	for (const FItemPtr& Item : AllItems)
+	{
+		Item->bResolves.Reset();
+	}
+	ListView->RebuildList();
+}
+
+#undef LOCTEXT_NAMESPACE
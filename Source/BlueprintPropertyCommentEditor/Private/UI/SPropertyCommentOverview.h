@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PropertyCommentPath.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class FBlueprintEditor;
+class FPropertyCommentResolver;
+class UBlueprint;
+class UPropertyCommentExtension;
+
+struct FPropertyCommentOverviewItem
+{
+	FPropertyCommentPath PropertyPath;
+	FString Key;
+
+	/** Checked the first time the item is shown, the resolver is only built for visible rows. */
+	TOptional<bool> bResolves;
+};
+
+/**
+ * Lists the comments of the blueprint open in a blueprint editor, sorted by key. The items only hold
+ * the keys, texts are read and keys resolved when the list view generates the row of an item.
+ * The filter matches property names and comment words, the latter through the token index of the extension.
+ */
+class SPropertyCommentOverview : public SCompoundWidget
+{
+public:
+	using FItemPtr = TSharedPtr<FPropertyCommentOverviewItem>;
+
+	SLATE_BEGIN_ARGS(SPropertyCommentOverview)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, TSharedPtr<FBlueprintEditor> InBlueprintEditor);
+	virtual ~SPropertyCommentOverview() override;
+
+private:
+	void RebuildItems();
+	void ApplyFilter();
+	void UpdateItem(const UPropertyCommentExtension& Extension, const FPropertyCommentPath& PropertyPath);
+	bool PassesFilter(const UPropertyCommentExtension& Extension, const FPropertyCommentOverviewItem& Item) const;
+	void OnFilterTextChanged(const FText& InText);
+	bool ResolveItem(FPropertyCommentOverviewItem& Item);
+
+	TSharedRef<ITableRow> OnGenerateRow(FItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnItemClicked(FItemPtr Item);
+	FText GetStatusText() const;
+
+	void HandleCommentsChanged(UPropertyCommentExtension* Extension, const FPropertyCommentPath* ChangedPath);
+	void HandleBlueprintChanged(UBlueprint* InBlueprint);
+
+	TWeakPtr<FBlueprintEditor> BlueprintEditor;
+	TWeakObjectPtr<UBlueprint> Blueprint;
+	TUniquePtr<FPropertyCommentResolver> Resolver;
+
+	TSharedPtr<SListView<FItemPtr>> ListView;
+
+	/** Every comment of the blueprint, sorted by key. */
+	TArray<FItemPtr> AllItems;
+
+	/** The items passing the filter, in the same order. */
+	TArray<FItemPtr> Items;
+	FString FilterText;
+
+	/** The filter as typed, a trailing space tells the token index that the last word is complete. */
+	FString FilterQuery;
+};
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UI/SPropertyCommentPreview.h"
+
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "PropertyCommentStats.h"
+#include "Rendering/DrawElements.h"
+
+namespace
+{
+	const FString Ellipsis{TEXT("\u2026")};
+}
+
+void SPropertyCommentPreview::Construct(const FArguments& InArgs)
+{
+	Text = InArgs._Text;
+	Font = InArgs._Font;
+	ColorAndOpacity = InArgs._ColorAndOpacity;
+
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	LineHeight = FontMeasure->GetMaxCharacterHeight(Font);
+}
+
+int32 SPropertyCommentPreview::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const FText CurrentText = Text.Get();
+	const float Width = AllottedGeometry.GetLocalSize().X;
+	if (!CurrentText.IdenticalTo(LayoutText) || Width != LayoutWidth)
+	{
+		UpdateLayout(CurrentText, Width);
+	}
+
+	if (!DisplayString.IsEmpty())
+	{
+		const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+		FSlateDrawElement::MakeText(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(), DisplayString, Font, DrawEffects,
+			InWidgetStyle.GetColorAndOpacityTint() * ColorAndOpacity.GetColor(InWidgetStyle));
+	}
+	return LayerId;
+}
+
+FVector2D SPropertyCommentPreview::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Takes whatever width the row gives it, the text is cut to fit
+	return FVector2D(0.0f, LineHeight);
+}
+
+void SPropertyCommentPreview::UpdateLayout(const FText& InText, float InWidth) const
+{
+	INC_DWORD_STAT(STAT_PropertyComment_PreviewLayouts);
+
+	LayoutText = InText;
+	LayoutWidth = InWidth;
+
+	const FString& String = InText.ToString();
+	int32 LineEnd = INDEX_NONE;
+	const bool bMultiLine = String.FindChar(TEXT('\n'), LineEnd);
+	FString FirstLine = bMultiLine ? String.Left(LineEnd).TrimEnd() : String;
+
+	const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+	if (!bMultiLine && FontMeasure->Measure(FirstLine, Font).X <= InWidth)
+	{
+		DisplayString = MoveTemp(FirstLine);
+		return;
+	}
+
+	// Keeps the characters that fit in front of the ellipsis
+	const float AvailableWidth = InWidth - FontMeasure->Measure(Ellipsis, Font).X;
+	const int32 LastIndex = AvailableWidth > 0.0f
+		? FontMeasure->FindLastWholeCharacterIndexBeforeOffset(FirstLine, Font, FMath::FloorToInt(AvailableWidth))
+		: INDEX_NONE;
+
+	DisplayString = FirstLine.Left(LastIndex + 1).TrimEnd() + Ellipsis;
+}
@@ -0,0 +1,49 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+#include "Styling/CoreStyle.h"
+#include "Styling/SlateColor.h"
+#include "Widgets/SLeafWidget.h"
+
+/**
+ * Single line preview of a comment, cut with an ellipsis where it stops fitting its width.
+ * The cut text is measured once and kept until the comment or the allotted width changes, so
+ * painting a preview costs one draw element per frame no matter how long the comment is.
+ */
+class SPropertyCommentPreview : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPropertyCommentPreview)
+		: _Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+		, _ColorAndOpacity(FSlateColor::UseForeground())
+	{
+	}
+		SLATE_ATTRIBUTE(FText, Text)
+		SLATE_ARGUMENT(FSlateFontInfo, Font)
+		SLATE_ARGUMENT(FSlateColor, ColorAndOpacity)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	//~ Begin SWidget Interface
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	//~ End SWidget Interface
+
+private:
+	void UpdateLayout(const FText& InText, float InWidth) const;
+
+	TAttribute<FText> Text;
+	FSlateFontInfo Font;
+	FSlateColor ColorAndOpacity;
+
+	// Layout cache, keyed by the text instance and the width it was cut for
+	mutable FText LayoutText;
+	mutable float LayoutWidth = -1.0f;
+	mutable FString DisplayString;
+	mutable uint16 LineHeight = 0;
+};
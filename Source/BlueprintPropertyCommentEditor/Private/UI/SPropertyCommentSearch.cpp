@@ -0,0 +1,144 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UI/SPropertyCommentSearch.h"
+
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "SPropertyCommentSearch"
+
+void SPropertyCommentSearch::Construct(const FArguments& InArgs)
+{
+	Search = MakeShared<FPropertyCommentSearch, ESPMode::ThreadSafe>();
+	Search->OnResults().BindSP(this, &SPropertyCommentSearch::HandleResults);
+	Search->OnQueryReset().BindSP(this, &SPropertyCommentSearch::HandleQueryReset);
+
+	ChildSlot
+	[
+		SNew(SVerticalBox)
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(SHorizontalBox)
+			+SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SNew(SSearchBox)
+				.HintText(LOCTEXT("SearchHint", "Search property comments"))
+				.OnTextChanged(this, &SPropertyCommentSearch::OnSearchTextChanged)
+			]
+
+			+SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(4.0f, 0.0f, 0.0f, 0.0f)
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("RescanButton", "Rescan"))
+				.OnClicked_Lambda([this]()
+				{
+					Search->StartScan();
+					return FReply::Handled();
+				})
+			]
+		]
+
+		+SVerticalBox::Slot()
+		.FillHeight(1.0f)
+		[
+			SAssignNew(ResultsView, SListView<FPropertyCommentSearchResult>)
+			.ListItemsSource(&Results)
+			.SelectionMode(ESelectionMode::Single)
+			.OnGenerateRow(this, &SPropertyCommentSearch::OnGenerateRow)
+			.OnMouseButtonDoubleClick(this, &SPropertyCommentSearch::OnResultDoubleClicked)
+		]
+
+		+SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(4.0f)
+		[
+			SNew(STextBlock)
+			.Text(this, &SPropertyCommentSearch::GetStatusText)
+		]
+	];
+
+	Search->StartScan();
+}
+
+SPropertyCommentSearch::~SPropertyCommentSearch()
+{
+	Search->Cancel();
+}
+
+TSharedRef<ITableRow> SPropertyCommentSearch::OnGenerateRow(FPropertyCommentSearchResult Result, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<FPropertyCommentSearchResult>, OwnerTable)
+	.ToolTipText(FText::FromString(Result->Comment))
+	[
+		SNew(SHorizontalBox)
+		+SHorizontalBox::Slot()
+		.FillWidth(0.25f)
+		.Padding(4.0f, 2.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Result->Blueprint.GetAssetName()))
+		]
+
+		+SHorizontalBox::Slot()
+		.FillWidth(0.25f)
+		.Padding(4.0f, 2.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Result->PropertyPath))
+		]
+
+		+SHorizontalBox::Slot()
+		.FillWidth(0.5f)
+		.Padding(4.0f, 2.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Result->Comment))
+		]
+	];
+}
+
+void SPropertyCommentSearch::OnResultDoubleClicked(FPropertyCommentSearchResult Result)
+{
+	if (Result && GEditor)
+	{
+		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Result->Blueprint.ToString());
+	}
+}
+
+void SPropertyCommentSearch::OnSearchTextChanged(const FText& InText)
+{
+	Search->SetQuery(InText.ToString());
+}
+
+void SPropertyCommentSearch::HandleResults(const TArray<FPropertyCommentSearchResult>& InResults)
+{
+	Results.Append(InResults);
+	ResultsView->RequestListRefresh();
+}
+
+void SPropertyCommentSearch::HandleQueryReset()
+{
+	Results.Reset();
+	ResultsView->RequestListRefresh();
+}
+
+FText SPropertyCommentSearch::GetStatusText() const
+{
+	if (Search->IsScanning())
+	{
+		return FText::Format(LOCTEXT("ScanningStatus", "Indexing... {0} comments indexed, {1} blueprints remaining. {2} results"),
+			Search->GetNumIndexedComments(), Search->GetNumPendingPackages(), Results.Num());
+	}
+
+	return FText::Format(LOCTEXT("IdleStatus", "{0} comments indexed. {1} results"), Search->GetNumIndexedComments(), Results.Num());
+}
+
+#undef LOCTEXT_NAMESPACE
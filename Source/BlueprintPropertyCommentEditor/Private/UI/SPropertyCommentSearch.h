@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Search/PropertyCommentSearch.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class SPropertyCommentSearch : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPropertyCommentSearch)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SPropertyCommentSearch() override;
+
+private:
+	TSharedRef<ITableRow> OnGenerateRow(FPropertyCommentSearchResult Result, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnResultDoubleClicked(FPropertyCommentSearchResult Result);
+	void OnSearchTextChanged(const FText& InText);
+	void HandleResults(const TArray<FPropertyCommentSearchResult>& InResults);
+	void HandleQueryReset();
+	FText GetStatusText() const;
+
+	TSharedPtr<FPropertyCommentSearch, ESPMode::ThreadSafe> Search;
+	TSharedPtr<SListView<FPropertyCommentSearchResult>> ResultsView;
+	TArray<FPropertyCommentSearchResult> Results;
+};
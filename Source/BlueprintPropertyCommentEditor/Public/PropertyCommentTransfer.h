@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FPropertyCommentTransferOptions
+{
+	/** Export every blueprint, including those whose asset registry tags report no comments. */
+	bool bAllBlueprints = false;
+
+	/** Restrict the export to these package paths (recursive). Empty means the whole project. */
+	TArray<FName> PackagePaths;
+
+	/** Save each modified package right after importing into it. Otherwise packages are only marked dirty. */
+	bool bSavePackages = true;
+
+	/** Number of packages loaded by the transfer before garbage is collected, bounding memory use. */
+	int32 PackagesPerGarbageCollection = 64;
+};
+
+struct FPropertyCommentTransferStats
+{
+	int32 NumBlueprints = 0;
+	int32 NumComments = 0;
+	int32 NumFailedBlueprints = 0;
+};
+
+/**
+ * Streams every property comment of the project to or from a UTF-8 text file with one record per line:
+ *
+ *     <blueprint object path> TAB <property path> TAB <comment>
+ *
+ * Tabs, line breaks and backslashes inside comments are escaped as \t, \n, \r and \\.
+ * An empty comment on import removes the comment. Lines starting with '#' are ignored.
+ *
+ * Both directions work one package at a time. On import, records for the same blueprint are
+ * expected on consecutive lines, and each package is marked dirty and saved once.
+ */
+class BLUEPRINTPROPERTYCOMMENTEDITOR_API FPropertyCommentTransfer
+{
+public:
+	static bool Export(const FString& Filename, const FPropertyCommentTransferOptions& Options, FPropertyCommentTransferStats& OutStats);
+	static bool Import(const FString& Filename, const FPropertyCommentTransferOptions& Options, FPropertyCommentTransferStats& OutStats);
+};